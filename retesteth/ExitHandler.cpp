@@ -1,5 +1,7 @@
 #include <retesteth/ExitHandler.h>
 #include <retesteth/TestOutputHelper.h>
+#include <retesteth/session/ThreadManager.h>
+#include <retesteth/session/ToolBackend/TransitionCache.h>
 #include <mutex>
 #include <thread>
 using namespace test;
@@ -20,8 +22,10 @@ void ExitHandler::doExit()
     static bool runOnce = false;
     if (!runOnce)
     {
+        ThreadManager::stopWorkers();
         RPCSession::clear();
         test::TestOutputHelper::printTestExecStats();
+        toolimpl::TransitionCache::printStats();
         runOnce = true;
     }
 }
@@ -56,6 +56,9 @@ void printHelp()
     cout << setw(40) << "--datadir" << setw(0) << "Path to configs (default: ~/.retesteth)\n";
     cout << setw(40) << "--nodes" << setw(0) << "List of client tcp ports (\"addr:ip, addr:ip\")\n";
     cout << setw(42) << " " << setw(0) << "Overrides the config file \"socketAddress\" section \n";
+    cout << setw(40) << "--toolcache <Folder>" << setw(0) << "Cache t8ntool results between runs in this folder\n";
+    cout << setw(40) << "--toolcachesize <MB>" << setw(0) << "Size limit of t8ntool results cache (default: 512)\n";
+    cout << setw(40) << "--timings <File>" << setw(0) << "Record test execution times in this file, run the slowest tests first\n";
     cout << setw(40) << "--help -h" << setw(25) << "Display list of command arguments\n";
     cout << setw(40) << "--version -v" << setw(25) << "Display build information\n";
     cout << setw(40) << "--list" << setw(25) << "Display available test suites\n";
@@ -80,6 +83,8 @@ void printHelp()
     cout << setw(30) << "--vmtrace.nomemory" << setw(25) << "Disable memory in vmtrace/vmtraceraw\n";
     cout << setw(30) << "--vmtrace.nostack" << setw(25) << "Disable stack in vmtrace/vmtraceraw\n";
     cout << setw(30) << "--vmtrace.noreturndata" << setw(25) << "Disable returndata in vmtrace/vmtraceraw\n";
+    cout << setw(30) << "--vmtrace.summary" << setw(25) << "Trace transaction execution, print only the summary of the trace\n";
+    cout << setw(30) << "--vmtrace.maxsize <MB>" << setw(25) << "Read at most <MB> of each trace for vmtrace/vmtraceraw\n";
     cout << setw(30) << "--limitblocks" << setw(25) << "Limit the block exectuion in blockchain tests for debug\n";
     cout << setw(30) << "--limitrpc" << setw(25) << "Limit the rpc exectuion in tests for debug\n";
     cout << setw(30) << "--verbosity <level>" << setw(25) << "Set logs verbosity. 0 - silent, 1 - only errors, 2 - informative, >2 - detailed\n";
@@ -220,6 +225,21 @@ Options::Options(int argc, const char** argv)
         {
             vmtrace_noreturndata = true;
         }
+        else if (arg == "--vmtrace.summary")
+        {
+            vmtrace = true;
+            vmtracesummary = true;
+        }
+        else if (arg == "--vmtrace.maxsize")
+        {
+            throwIfNoArgumentFollows();
+            string const sizeMB = argv[++i];
+            size_t const maxDigits = 7;  // up to ~10TB
+            if (sizeMB.empty() || sizeMB.size() > maxDigits || test::stringIntegerType(sizeMB) != DigitsType::Decimal ||
+                atoi(sizeMB.c_str()) <= 0)
+                BOOST_THROW_EXCEPTION(InvalidOption("--vmtrace.maxsize expects a positive number of MB, got: `" + sizeMB + "`"));
+            vmtraceMaxSizeMB = atoi(sizeMB.c_str());
+        }
         else if (arg == "--jsontrace")
         {
             throwIfNoArgumentFollows();
@@ -367,6 +387,28 @@ Options::Options(int argc, const char** argv)
             throwIfNoArgumentFollows();
             datadir = fs::path(std::string{argv[++i]});
         }
+        else if (arg == "--toolcache")
+        {
+            throwIfNoArgumentFollows();
+            toolCacheDir = fs::path(std::string{argv[++i]});
+            if (!fs::exists(toolCacheDir.get()))
+                fs::create_directories(toolCacheDir.get());
+        }
+        else if (arg == "--toolcachesize")
+        {
+            throwIfNoArgumentFollows();
+            string const sizeMB = argv[++i];
+            size_t const maxDigits = 7;  // up to ~10TB
+            if (sizeMB.empty() || sizeMB.size() > maxDigits || test::stringIntegerType(sizeMB) != DigitsType::Decimal ||
+                atoi(sizeMB.c_str()) <= 0)
+                BOOST_THROW_EXCEPTION(InvalidOption("--toolcachesize expects a positive number of MB, got: `" + sizeMB + "`"));
+            toolCacheSizeMB = atoi(sizeMB.c_str());
+        }
+        else if (arg == "--timings")
+        {
+            throwIfNoArgumentFollows();
+            timingsFile = fs::path(std::string{argv[++i]});
+        }
         else if (arg == "--nodes")
         {
             throwIfNoArgumentFollows();
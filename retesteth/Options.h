@@ -41,6 +41,8 @@ public:
     bool vmtrace_nomemory = false;
     bool vmtrace_nostack = false;
     bool vmtrace_noreturndata = false;
+    bool vmtracesummary = false;       ///< Create EVM execution tracer. output trace summary only
+    size_t vmtraceMaxSizeMB = 0;       ///< Stop reading the trace after this size. 0 - no limit
 
     bool filltests = false;            ///< Create JSON test files from execution results
     bool showhash = false;  ///< Show filler hash for debug information
@@ -54,6 +56,9 @@ public:
     bool nologcolor = false;
     std::string statsOutFile; ///< Stats output file. "out" for standard output
     fs::path datadir;         ///< Path to datadir (~/.retesteth)
+    boost::optional<fs::path> toolCacheDir;  ///< Persist t8ntool backend caches in this folder
+    size_t toolCacheSizeMB = 512;            ///< Size limit of t8ntool results cache
+    boost::optional<fs::path> timingsFile;   ///< Record filler execution times here, run the slowest first
     std::vector<IPADDRESS> nodesoverride;  ///< ["IP:port", ""IP:port""] array
     bool exectimelog = false; ///< Print execution time for each test suite
 	std::string rCurrentTestSuite; ///< Remember test suite before boost overwrite (for random tests)
@@ -0,0 +1,417 @@
+#include "SpawnServer.h"
+#include <retesteth/EthChecks.h>
+#include <atomic>
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <fcntl.h>
+#include <map>
+#include <poll.h>
+#include <spawn.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <thread>
+#include <unistd.h>
+
+extern char** environ;
+
+using namespace std;
+
+namespace
+{
+// Control socket to the spawn server, -1 if the server is not running
+std::atomic<int> g_controlSocket(-1);
+size_t const c_maxCommandSize = 65536;
+
+// Threads that are sending a request over the control socket. It is closed when there are none
+std::atomic<int> g_controlUsers(0);
+
+// Stop using the spawn server after it went away. Only the thread that takes the socket out closes it
+void disableControlSocket(int _socket, string const& _reason)
+{
+    int expected = _socket;
+    if (!g_controlSocket.compare_exchange_strong(expected, -1))
+        return;
+    ETH_WARNING("SpawnServer " + _reason + ", spawning commands from retesteth process");
+
+    // Wake up the senders blocked on the socket, the descriptor is not reused while they hold it
+    shutdown(_socket, SHUT_RDWR);
+    while (g_controlUsers.load() > 0)
+        std::this_thread::yield();
+    close(_socket);
+}
+
+// Send int32 with up to two descriptors attached
+bool sendWithFds(int _socket, int32_t _value, int const* _fds, size_t _fdCount)
+{
+    struct iovec iov;
+    iov.iov_base = &_value;
+    iov.iov_len = sizeof(_value);
+
+    char control[CMSG_SPACE(2 * sizeof(int))];
+    memset(control, 0, sizeof(control));
+    struct msghdr msg;
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    if (_fdCount > 0)
+    {
+        msg.msg_control = control;
+        msg.msg_controllen = CMSG_SPACE(_fdCount * sizeof(int));
+        struct cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+        cmsg->cmsg_level = SOL_SOCKET;
+        cmsg->cmsg_type = SCM_RIGHTS;
+        cmsg->cmsg_len = CMSG_LEN(_fdCount * sizeof(int));
+        memcpy(CMSG_DATA(cmsg), _fds, _fdCount * sizeof(int));
+    }
+
+    ssize_t res;
+    while ((res = sendmsg(_socket, &msg, MSG_NOSIGNAL)) == -1 && errno == EINTR)
+        ;
+    return res == sizeof(_value);
+}
+
+// Receive message with up to two descriptors attached. Return message size
+ssize_t recvWithFds(int _socket, void* _buffer, size_t _size, int* _fds, size_t& _fdCount)
+{
+    struct iovec iov;
+    iov.iov_base = _buffer;
+    iov.iov_len = _size;
+
+    char control[CMSG_SPACE(2 * sizeof(int))];
+    struct msghdr msg;
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = control;
+    msg.msg_controllen = sizeof(control);
+
+    ssize_t res;
+    while ((res = recvmsg(_socket, &msg, MSG_CMSG_CLOEXEC)) == -1 && errno == EINTR)
+        ;
+
+    _fdCount = 0;
+    for (struct cmsghdr* cmsg = CMSG_FIRSTHDR(&msg); cmsg != NULL; cmsg = CMSG_NXTHDR(&msg, cmsg))
+    {
+        if (cmsg->cmsg_level != SOL_SOCKET || cmsg->cmsg_type != SCM_RIGHTS)
+            continue;
+        size_t const count = (cmsg->cmsg_len - CMSG_LEN(0)) / sizeof(int);
+        for (size_t i = 0; i < count; i++)
+        {
+            int fd;
+            memcpy(&fd, CMSG_DATA(cmsg) + i * sizeof(int), sizeof(int));
+            if (_fdCount < 2)
+                _fds[_fdCount++] = fd;
+            else
+                close(fd);
+        }
+    }
+    if (res >= 0 && (msg.msg_flags & MSG_TRUNC))
+        return -1;
+    return res;
+}
+
+// posix_spawn `/bin/sh -c _command` with stdin/stdout bound to new pipes
+// Return pid or -errno. _fds receive stdin write end and stdout read end
+pid_t spawnShell(char const* _command, int* _fds, bool _newProcessGroup)
+{
+    int fdIn[2];
+    int fdOut[2];
+    if (socketpair(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0, fdIn) == -1)
+        return -errno;
+    if (pipe2(fdOut, O_CLOEXEC) == -1)
+    {
+        int const err = errno;
+        close(fdIn[0]);
+        close(fdIn[1]);
+        return -err;
+    }
+
+    posix_spawn_file_actions_t actions;
+    posix_spawn_file_actions_init(&actions);
+    posix_spawn_file_actions_adddup2(&actions, fdIn[0], 0);
+    posix_spawn_file_actions_adddup2(&actions, fdOut[1], 1);
+
+    // Children get default signal handling regardless of the caller setup
+    posix_spawnattr_t attr;
+    posix_spawnattr_init(&attr);
+    sigset_t sigs;
+    sigemptyset(&sigs);
+    posix_spawnattr_setsigmask(&attr, &sigs);
+    sigaddset(&sigs, SIGINT);
+    sigaddset(&sigs, SIGPIPE);
+    sigaddset(&sigs, SIGCHLD);
+    posix_spawnattr_setsigdefault(&attr, &sigs);
+    short flags = POSIX_SPAWN_SETSIGMASK | POSIX_SPAWN_SETSIGDEF;
+    if (_newProcessGroup)
+    {
+        // Group is set before exec, there is no window where the child is outside of it
+        posix_spawnattr_setpgroup(&attr, 0);
+        flags |= POSIX_SPAWN_SETPGROUP;
+    }
+    posix_spawnattr_setflags(&attr, flags);
+
+    pid_t pid = 0;
+    char* const argv[] = {(char*)"sh", (char*)"-c", (char*)_command, NULL};
+    int const err = posix_spawn(&pid, "/bin/sh", &actions, &attr, argv, environ);
+    posix_spawnattr_destroy(&attr);
+    posix_spawn_file_actions_destroy(&actions);
+    close(fdIn[0]);
+    close(fdOut[1]);
+    if (err != 0)
+    {
+        close(fdIn[1]);
+        close(fdOut[0]);
+        return -err;
+    }
+    _fds[0] = fdIn[1];
+    _fds[1] = fdOut[0];
+    return pid;
+}
+
+// SIGCHLD handler of the server wakes up its poll loop
+int g_sigchldPipe[2] = {-1, -1};
+void onSigchld(int)
+{
+    int const savedErrno = errno;
+    ssize_t res = write(g_sigchldPipe[1], "c", 1);
+    (void)res;
+    errno = savedErrno;
+}
+
+// Spawn server process main loop. Exits when retesteth closes the control socket
+[[noreturn]] void serverLoop(int _control)
+{
+    signal(SIGINT, SIG_IGN);
+    signal(SIGTERM, SIG_DFL);
+    signal(SIGABRT, SIG_DFL);
+    signal(SIGPIPE, SIG_IGN);
+    if (pipe2(g_sigchldPipe, O_CLOEXEC | O_NONBLOCK) == -1)
+        _exit(1);
+    struct sigaction sa;
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = onSigchld;
+    sa.sa_flags = SA_RESTART | SA_NOCLDSTOP;
+    sigaction(SIGCHLD, &sa, NULL);
+
+    std::map<pid_t, int> running;  // child pid => reply socket
+    std::string command(c_maxCommandSize, 0);
+    struct pollfd fds[2];
+    fds[0].fd = _control;
+    fds[0].events = POLLIN;
+    fds[1].fd = g_sigchldPipe[0];
+    fds[1].events = POLLIN;
+    while (true)
+    {
+        if (poll(fds, 2, -1) == -1)
+        {
+            if (errno == EINTR)
+                continue;
+            break;
+        }
+
+        if (fds[1].revents)
+        {
+            char drain[64];
+            while (read(g_sigchldPipe[0], drain, sizeof(drain)) > 0)
+                ;
+            int status = 0;
+            pid_t pid;
+            while ((pid = waitpid(-1, &status, WNOHANG)) > 0)
+            {
+                auto const it = running.find(pid);
+                if (it == running.end())
+                    continue;
+                sendWithFds(it->second, status, NULL, 0);
+                close(it->second);
+                running.erase(it);
+            }
+        }
+
+        if (fds[0].revents)
+        {
+            int reply[2];
+            size_t replyCount = 0;
+            ssize_t const size = recvWithFds(_control, &command[0], command.size() - 1, reply, replyCount);
+            if (size <= 0 && replyCount == 0)
+                break;
+            if (replyCount == 0)
+                continue;
+            for (size_t i = 1; i < replyCount; i++)
+                close(reply[i]);
+
+            int childFds[2];
+            pid_t pid = -EINVAL;
+            if (size > 1)
+            {
+                command[size] = 0;
+                pid = spawnShell(command.c_str() + 1, childFds, command[0] == 'g');
+            }
+            sendWithFds(reply[0], pid, childFds, pid > 0 ? 2 : 0);
+            if (pid > 0)
+            {
+                close(childFds[0]);
+                close(childFds[1]);
+                running[pid] = reply[0];
+            }
+            else
+                close(reply[0]);
+        }
+    }
+    _exit(0);
+}
+
+}  // namespace
+
+namespace test
+{
+void SpawnServer::start()
+{
+    if (g_controlSocket != -1)
+        return;
+
+    int fds[2];
+    if (socketpair(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0, fds) == -1)
+        return;
+
+    pid_t const pid = fork();
+    if (pid == -1)
+    {
+        close(fds[0]);
+        close(fds[1]);
+        return;
+    }
+    if (pid == 0)
+    {
+        close(fds[0]);
+        serverLoop(fds[1]);
+    }
+    close(fds[1]);
+    g_controlSocket = fds[0];
+}
+
+SpawnedCmd SpawnServer::spawn(string const& _command, bool _newProcessGroup)
+{
+    SpawnedCmd cmd;
+    int fds[2];
+    string const message = (_newProcessGroup ? "g" : "-") + _command;
+    g_controlUsers++;
+    int const controlSocket = g_controlSocket.load();
+    if (controlSocket == -1 || message.size() >= c_maxCommandSize)
+        g_controlUsers--;
+    else
+    {
+        int reply[2];
+        if (socketpair(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0, reply) == -1)
+        {
+            g_controlUsers--;
+            ETH_FAIL_MESSAGE("SpawnServer failed to create socket pair for " + _command);
+        }
+
+        // Seqpacket message is atomic, threads do not need to lock the control socket
+        struct iovec iov;
+        iov.iov_base = (void*)message.data();
+        iov.iov_len = message.size();
+        char control[CMSG_SPACE(sizeof(int))];
+        memset(control, 0, sizeof(control));
+        struct msghdr msg;
+        memset(&msg, 0, sizeof(msg));
+        msg.msg_iov = &iov;
+        msg.msg_iovlen = 1;
+        msg.msg_control = control;
+        msg.msg_controllen = sizeof(control);
+        struct cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+        cmsg->cmsg_level = SOL_SOCKET;
+        cmsg->cmsg_type = SCM_RIGHTS;
+        cmsg->cmsg_len = CMSG_LEN(sizeof(int));
+        memcpy(CMSG_DATA(cmsg), &reply[1], sizeof(int));
+
+        ssize_t res;
+        while ((res = sendmsg(controlSocket, &msg, MSG_NOSIGNAL)) == -1 && errno == EINTR)
+            ;
+        int const sendErrno = errno;
+        g_controlUsers--;
+        close(reply[1]);
+
+        int32_t pid = 0;
+        size_t fdCount = 0;
+        ssize_t received = 0;
+        int recvErrno = 0;
+        if (res == (ssize_t)message.size())
+        {
+            received = recvWithFds(reply[0], &pid, sizeof(pid), fds, fdCount);
+            recvErrno = errno;
+            if (received == sizeof(pid) && pid > 0 && fdCount == 2)
+            {
+                cmd.pid = pid;
+                cmd.fdIn = fds[0];
+                cmd.fdOut = fds[1];
+                cmd.server = reply[0];
+                return cmd;
+            }
+        }
+        for (size_t i = 0; i < fdCount; i++)
+            close(fds[i]);
+        close(reply[0]);
+        if (received == sizeof(pid) && pid < 0)
+            ETH_FAIL_MESSAGE("Failed to run " + _command + " (" + strerror(-pid) + ")");
+
+        // The server is gone if it closed the socket. Other errors fall back for this command only
+        if (res == -1 && (sendErrno == EPIPE || sendErrno == ECONNRESET || sendErrno == ENOTCONN))
+            disableControlSocket(controlSocket, string("request failed: ") + strerror(sendErrno));
+        else if (res != -1 && received == 0)
+            disableControlSocket(controlSocket, "closed the connection");
+        else if (res == -1)
+            ETH_WARNING(string("SpawnServer request failed: ") + strerror(sendErrno) + ", spawning " + _command +
+                        " from retesteth process");
+        else if (received == -1)
+            ETH_WARNING(string("SpawnServer reply failed: ") + strerror(recvErrno) + ", spawning " + _command +
+                        " from retesteth process");
+        else
+            ETH_WARNING("SpawnServer sent a malformed reply, spawning " + _command + " from retesteth process");
+    }
+
+    // posix_spawn does not copy retesteth memory, descriptors are close on exec, so no locking
+    pid_t const pid = spawnShell(_command.c_str(), fds, _newProcessGroup);
+    if (pid < 0)
+        ETH_FAIL_MESSAGE("Failed to run " + _command + " (" + strerror(-pid) + ")");
+    cmd.pid = pid;
+    cmd.fdIn = fds[0];
+    cmd.fdOut = fds[1];
+    return cmd;
+}
+
+int SpawnServer::wait(SpawnedCmd& _cmd)
+{
+    if (_cmd.fdIn != -1)
+        close(_cmd.fdIn);
+    if (_cmd.fdOut != -1)
+        close(_cmd.fdOut);
+    _cmd.fdIn = -1;
+    _cmd.fdOut = -1;
+
+    int status = 0;
+    if (_cmd.server != -1)
+    {
+        // Child of the spawn server, it reports the status when the child exits
+        int32_t serverStatus = -1;
+        size_t fdCount = 0;
+        int fds[2];
+        if (recvWithFds(_cmd.server, &serverStatus, sizeof(serverStatus), fds, fdCount) != sizeof(serverStatus))
+            serverStatus = -1;
+        for (size_t i = 0; i < fdCount; i++)
+            close(fds[i]);
+        close(_cmd.server);
+        _cmd.server = -1;
+        status = serverStatus;
+    }
+    else
+    {
+        while (waitpid(_cmd.pid, &status, 0) == -1 && errno == EINTR)
+            ;
+    }
+    _cmd.pid = 0;
+    return status;
+}
+
+}  // namespace test
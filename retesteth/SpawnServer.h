@@ -0,0 +1,39 @@
+#pragma once
+#include <string>
+#include <sys/types.h>
+
+namespace test
+{
+// Shell command launched with stdin/stdout connected to retesteth
+struct SpawnedCmd
+{
+    pid_t pid = 0;
+    int fdIn = -1;     // child stdin (socket, writing to a dead child returns EPIPE)
+    int fdOut = -1;    // child stdout
+    int server = -1;   // spawn server connection, reports the exit status
+};
+
+// Small process forked at retesteth start while it is still tiny
+// Launches tool/solc/lllc commands with posix_spawn on request and passes the pipes back over a unix socket,
+// so spawning does not copy the big retesteth address space and does not need to be serialized between threads
+//
+// Protocol (seqpacket control socket, one message per request):
+//   request:  flags char ('g' new process group, '-' none) and command string, SCM_RIGHTS with the reply socket
+//   reply:    int32 pid (or -errno), SCM_RIGHTS with child stdin and stdout
+//             int32 wait status when the child exits
+class SpawnServer
+{
+public:
+    // Fork the server. Must be called before any threads are created
+    static void start();
+
+    // Run `/bin/sh -c _command` via the server
+    // If the server is not running, the command is spawned from retesteth process
+    // With _newProcessGroup the child leads its own process group, so kill(-pid) reaches its children too
+    static SpawnedCmd spawn(std::string const& _command, bool _newProcessGroup = false);
+
+    // Close the child pipes and wait for its exit. Return the wait status
+    static int wait(SpawnedCmd& _cmd);
+};
+
+}  // namespace test
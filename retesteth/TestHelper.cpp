@@ -9,10 +9,17 @@
 #include <boost/uuid/uuid_io.hpp>
 
 #include <csignal>
+#include <map>
 #include <mutex>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <thread>
+#include <unistd.h>
 
 #include <libdevcore/CommonIO.h>
 #include <retesteth/Options.h>
+#include <retesteth/SpawnServer.h>
 #include <retesteth/TestHelper.h>
 #include <retesteth/TestOutputHelper.h>
 #include <retesteth/dataObject/ConvertFile.h>
@@ -399,6 +406,65 @@ void strToLower(string& _input)
     std::transform(_input.begin(), _input.end(), _input.begin(), [](unsigned char c) { return std::tolower(c); });
 }
 
+namespace
+{
+std::mutex g_cmdPathCacheMutex;
+std::map<string, string> g_cmdPathCache;
+CmdPathCacheStats g_cmdPathCacheStats;
+
+// Same lookup as `which`, but without spawning a process
+string findCmdInPath(string const& _cmd)
+{
+    if (_cmd.empty())
+        return string();
+    if (_cmd.find('/') != string::npos)
+        return access(_cmd.c_str(), X_OK) == 0 ? _cmd : string();
+
+    char const* envPath = getenv("PATH");
+    if (envPath == NULL)
+        return string();
+    for (auto const& dir : explode(envPath, ':'))
+    {
+        fs::path const path = fs::path(dir.empty() ? "." : dir) / _cmd;
+        boost::system::error_code ec;
+        if (fs::is_regular_file(path, ec) && access(path.c_str(), X_OK) == 0)
+            return path.string();
+    }
+    return string();
+}
+}  // namespace
+
+string resolveCmdPath(string const& _cmd)
+{
+    {
+        std::lock_guard<std::mutex> lock(g_cmdPathCacheMutex);
+        auto const it = g_cmdPathCache.find(_cmd);
+        if (it != g_cmdPathCache.end())
+        {
+            g_cmdPathCacheStats.saved++;
+            return it->second;
+        }
+    }
+
+    string const path = findCmdInPath(_cmd);
+    std::lock_guard<std::mutex> lock(g_cmdPathCacheMutex);
+    g_cmdPathCache.emplace(_cmd, path);
+    g_cmdPathCacheStats.resolved++;
+    return path;
+}
+
+void resetCmdPathCache()
+{
+    std::lock_guard<std::mutex> lock(g_cmdPathCacheMutex);
+    g_cmdPathCache.clear();
+}
+
+CmdPathCacheStats cmdPathCacheStats()
+{
+    std::lock_guard<std::mutex> lock(g_cmdPathCacheMutex);
+    return g_cmdPathCacheStats;
+}
+
 bool checkCmdExist(std::string const& _command)
 {
     string cmd;
@@ -408,51 +474,98 @@ bool checkCmdExist(std::string const& _command)
     else
         cmd = _command;
 
-    string const checkCmd = string("which " + cmd + " > /dev/null 2>&1");
-    bool const checkBoost = fs::exists(cmd);
-    if (!checkBoost && system(checkCmd.c_str()))
-        return false;
-    return true;
+    if (fs::exists(cmd))
+        return true;
+    return !resolveCmdPath(cmd).empty();
 }
 
-mutex g_popenmutex;
 string executeCmd(string const& _command, ExecCMDWarning _warningOnEmpty)
+{
+    return executeCmdWithInput(_command, string(), _warningOnEmpty);
+}
+
+namespace
+{
+// Describe the wait status of a finished command
+string exitStatusString(int _status)
+{
+    if (WIFSIGNALED(_status))
+        return "was killed by signal " + toString(WTERMSIG(_status));
+    if (WIFEXITED(_status))
+        return "exited with " + toString(WEXITSTATUS(_status)) + " code";
+    return "exited with unknown status " + toString(_status);
+}
+}  // namespace
+
+string executeCmdWithInput(string const& _command, string const& _input, ExecCMDWarning _warningOnEmpty)
 {
 #if defined(_WIN32)
-    BOOST_ERROR("executeCmd() has not been implemented for Windows.");
+    BOOST_ERROR("executeCmdWithInput() has not been implemented for Windows.");
     return "";
 #else
-    string out;
-    char output[1024];
     ETH_FAIL_REQUIRE_MESSAGE(!_command.empty(), "executeCmd: empty argument!");
     if (!test::checkCmdExist(_command))
         ETH_FAIL_MESSAGE("Command `" + _command + "` does not found!");
 
-    FILE* fp;
-    {
-        std::lock_guard<std::mutex> lock(g_popenmutex);
-        fp = popen(_command.c_str(), "r");
-    }
-    if (fp == NULL || fp == 0)
-        ETH_FAIL_MESSAGE("Failed to run " + _command);
-    if (fgets(output, sizeof(output) - 1, fp) == NULL)
+    // Spawned by the spawn server in parallel with other threads
+    // Stdin is a socket so writing to a dead child returns EPIPE instead of raising SIGPIPE
+    SpawnedCmd child = SpawnServer::spawn(_command);
+
+    // Write stdin and read stdout at the same time, so the child never blocks on a full pipe
+    string out;
+    char output[65536];
+    size_t written = 0;
+    struct pollfd fds[2];
+    fds[0].fd = child.fdOut;
+    fds[0].events = POLLIN;
+    fds[1].fd = _input.empty() ? -1 : child.fdIn;
+    fds[1].events = POLLOUT;
+    if (_input.empty())
     {
-        if (_warningOnEmpty == ExecCMDWarning::WarningOnEmptyResult)
-            ETH_WARNING("Reading empty result for " + _command);
+        close(child.fdIn);
+        child.fdIn = -1;
     }
-    else
+    while (fds[0].fd != -1)
     {
-        while (true)
+        if (poll(fds, 2, -1) == -1)
         {
-            out += string(output);
-            if (fgets(output, sizeof(output) - 1, fp) == NULL)
-                break;
+            if (errno == EINTR)
+                continue;
+            break;
+        }
+        if (fds[1].fd != -1 && fds[1].revents)
+        {
+            ssize_t res = -1;
+            if (fds[1].revents & POLLOUT)
+            {
+                res = send(child.fdIn, _input.data() + written, _input.size() - written, MSG_NOSIGNAL | MSG_DONTWAIT);
+                if (res == -1 && (errno == EINTR || errno == EAGAIN || errno == EWOULDBLOCK))
+                    continue;
+            }
+            if (res > 0)
+                written += (size_t)res;
+            if (res <= 0 || written == _input.size())
+            {
+                close(child.fdIn);
+                child.fdIn = -1;
+                fds[1].fd = -1;
+            }
+        }
+        if (fds[0].revents)
+        {
+            ssize_t const res = read(child.fdOut, output, sizeof(output));
+            if (res > 0)
+                out.append(output, (size_t)res);
+            else if (res == 0 || errno != EINTR)
+                fds[0].fd = -1;
         }
     }
 
-    int exitCode = pclose(fp);
-    if (exitCode != 0 && _warningOnEmpty != ExecCMDWarning::NoWarningNoError)
-        ETH_ERROR_MESSAGE("The command '" + _command + "' exited with " + toString(exitCode) + " code.");
+    int const status = SpawnServer::wait(child);
+    if (out.empty() && _warningOnEmpty == ExecCMDWarning::WarningOnEmptyResult)
+        ETH_WARNING("Reading empty result for " + _command);
+    if (status != 0 && _warningOnEmpty != ExecCMDWarning::NoWarningNoError)
+        ETH_ERROR_MESSAGE("The command '" + _command + "' " + exitStatusString(status) + ".");
     return boost::trim_copy(out);
 #endif
 }
@@ -596,6 +709,25 @@ int pclose2(FILE* _fp, pid_t _pid)
     return ret;
 }
 
+bool waitProcessExit(pid_t _pid, size_t _timeoutMS)
+{
+    if (_pid <= 0)
+        return true;
+    auto const deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(_timeoutMS);
+    size_t delayMS = 10;
+    while (true)
+    {
+        // Reap our own child, otherwise check that the process is gone
+        pid_t const res = waitpid(_pid, NULL, WNOHANG);
+        if (res == _pid || (res < 0 && errno == ECHILD && kill(_pid, 0) != 0))
+            return true;
+        if (std::chrono::steady_clock::now() >= deadline)
+            return false;
+        std::this_thread::sleep_for(std::chrono::milliseconds(delayMS));
+        delayMS = std::min<size_t>(delayMS * 2, 500);
+    }
+}
+
 std::mutex g_createUniqueTmpDirectory;
 fs::path createUniqueTmpDirectory() {
     std::lock_guard<std::mutex> lock(g_createUniqueTmpDirectory);
@@ -609,79 +741,87 @@ fs::path createUniqueTmpDirectory() {
 }
 
 // RLPStream emulator
+void RLPStreamU::append(string const& _data, bool _wrapString)
+{
+    if (m_items.size() >= m_size)
+        ETH_FAIL_MESSAGE("RLPStreamU append called more than " + fto_string(m_size) + " times!");
+    m_items.push_back({&_data, _wrapString});
+}
+
 void RLPStreamU::appendString(string const& _data)
 {
-    if (m_data != 0)
-        ETH_FAIL_MESSAGE("RLPStreamU::appendString called more than 1 times!");
-    m_data = &_data;
-    m_wrapString = true;
+    append(_data, true);
 }
 
 void RLPStreamU::appendRaw(string const& _data)
 {
-    if (m_data != 0)
-        ETH_FAIL_MESSAGE("RLPStreamU::appendRaw called more than 1 times!");
-    m_data = &_data;
+    append(_data, false);
 }
 
+namespace
+{
 // RLPStream emulator
-string RLPStreamU::outHeader() const
+
+// If a string is 0-55 bytes long, the RLP encoding consists of a single byte with value 0x80 plus the length of
+// the string followed by the string. The range of the first byte is thus [0x80, 0xb7]. If a string is more than 55 bytes
+// long, the RLP encoding consists of a single byte with value 0xb7 plus the length in bytes of the length of the string in
+// binary form, followed by the length of the string, followed by the string. For example, a length-1024 string would be
+// encoded as \xb9\x04\x00 followed by the string. The range of the first byte is thus [0xb8, 0xbf].
+//
+// If the total payload of a list (i.e. the combined length of all its items being RLP encoded) is 0-55 bytes long, the RLP
+// encoding consists of a single byte with value 0xc0 plus the length of the list followed by the concatenation of the RLP
+// encodings of the items. The range of the first byte is thus [0xc0, 0xf7]. If the total payload of a list is more than 55
+// bytes long, the RLP encoding consists of a single byte with value 0xf7 plus the length in bytes of the length of the
+// payload in binary form, followed by the length of the payload, followed by the concatenation of the RLP encodings of the
+// items. The range of the first byte is thus [0xf8, 0xff].
+string rlpHeader(size_t _payloadSize, size_t _shortOffset, size_t _longOffset)
 {
-    // For a single byte whose value is in the [0x00, 0x7f] range, that byte is its own RLP encoding.
-    // Otherwise, if a string is 0-55 bytes long, the RLP encoding consists of a single byte with value 0x80 plus the length of
-    // the string followed by the string. The range of the first byte is thus [0x80, 0xb7]. If a string is more than 55 bytes
-    // long, the RLP encoding consists of a single byte with value 0xb7 plus the length in bytes of the length of the string in
-    // binary form, followed by the length of the string, followed by the string. For example, a length-1024 string would be
-    // encoded as \xb9\x04\x00 followed by the string. The range of the first byte is thus [0xb8, 0xbf].
-
-    // If the total payload of a list (i.e. the combined length of all its items being RLP encoded) is 0-55 bytes long, the RLP
-    // encoding consists of a single byte with value 0xc0 plus the length of the list followed by the concatenation of the RLP
-    // encodings of the items. The range of the first byte is thus [0xc0, 0xf7]. If the total payload of a list is more than 55
-    // bytes long, the RLP encoding consists of a single byte with value 0xf7 plus the length in bytes of the length of the
-    // payload in binary form, followed by the length of the payload, followed by the concatenation of the RLP encodings of the
-    // items. The range of the first byte is thus [0xf8, 0xff].
-
-    size_t header;
-    long payloadSize = (m_data->size() / 2) - 1;
-    string wrappedStringHeaderStr = "";
-    if (m_wrapString)
+    if (_payloadSize > 55)
     {
-        // if a string is 0-55 bytes long, the RLP encoding consists of a single byte
-        // with value 0x80 plus the length of the string followed by the string.
-        // The range of the first byte is thus [0x80, 0xb7].
+        auto const lengthOfThePayload = dev::toCompactHex(_payloadSize);
+        return dev::toCompactHex(_longOffset + lengthOfThePayload.size() / 2) + lengthOfThePayload;
+    }
+    return dev::toCompactHex(_shortOffset + _payloadSize);
+}
 
-        // If a string is more than 55 bytes long, the RLP encoding consists of a single byte
-        // with value 0xb7 plus the length in bytes of the length of the string in binary form,
-        // followed by the length of the string, followed by the string.
-        // For example, a length-1024 string would be encoded as \xb9\x04\x00 followed by the string.
-        // The range of the first byte is thus [0xb8, 0xbf].
+string rlpStringHeader(size_t _payloadSize)
+{
+    return rlpHeader(_payloadSize, 128, 183);
+}
 
-        if (payloadSize > 55)
-        {
-            auto const lengthOfTheString = dev::toCompactHex(payloadSize);
-            auto const lengthInBytesOfTheLengthOfTheStringInBinaryForm = lengthOfTheString.size() / 2;
+string rlpListHeader(size_t _payloadSize)
+{
+    return rlpHeader(_payloadSize, 192, 247);
+}
+}  // namespace
 
-            size_t const wrappedStringHeader = 183 + lengthInBytesOfTheLengthOfTheStringInBinaryForm;
-            wrappedStringHeaderStr = dev::toCompactHex(wrappedStringHeader) + lengthOfTheString;
-        }
-        else
-        {
-            size_t wrappedStringHeader = 128 + payloadSize;
-            wrappedStringHeaderStr = dev::toCompactHex(wrappedStringHeader);
-        }
+string RLPStreamU::outHeader() const
+{
+    if (m_items.size() != 1)
+        ETH_FAIL_MESSAGE("RLPStreamU::outHeader expects a stream of 1 rlp item. Use RLPStreamU::out");
+
+    Item const& item = m_items.at(0);
+    size_t payloadSize = (item.data->size() / 2) - 1;
+    string wrappedStringHeaderStr = "";
+    if (item.wrapString)
+    {
+        wrappedStringHeaderStr = rlpStringHeader(payloadSize);
         payloadSize += wrappedStringHeaderStr.size() / 2;
     }
+    return "0x" + rlpListHeader(payloadSize) + wrappedStringHeaderStr;
+}
 
-    if (payloadSize > 55)
+string RLPStreamU::out() const
+{
+    string payload;
+    for (auto const& item : m_items)
     {
-        auto const lengthOfThePayload = dev::toCompactHex(payloadSize);
-        auto const theLengthInBytesOfTheLengthOfThePayloadInBinaryForm = lengthOfThePayload.size() / 2;
-        header = 247 + theLengthInBytesOfTheLengthOfThePayloadInBinaryForm;
-        return "0x" + dev::toCompactHex(header) + lengthOfThePayload + wrappedStringHeaderStr;
+        size_t const itemSize = (item.data->size() / 2) - 1;
+        if (item.wrapString)
+            payload += rlpStringHeader(itemSize);
+        payload += item.data->substr(2);
     }
-    else
-        header = 192 + payloadSize;
-    return "0x" + dev::toCompactHex(header) + wrappedStringHeaderStr;
+    return "0x" + rlpListHeader(payload.size() / 2) + payload;
 }
 
 }//namespace
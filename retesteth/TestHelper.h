@@ -64,6 +64,17 @@ std::string prepareSolidityVersionString();
 /// check system command
 bool checkCmdExist(std::string const& _command);
 
+/// Executable path of the command found in PATH (empty if not found)
+/// Resolved paths are cached until the cache is reset on client config change
+std::string resolveCmdPath(std::string const& _cmd);
+void resetCmdPathCache();
+struct CmdPathCacheStats
+{
+    size_t resolved = 0;  // PATH lookups done
+    size_t saved = 0;     // lookups served from the cache
+};
+CmdPathCacheStats cmdPathCacheStats();
+
 /// run system command
 enum class ExecCMDWarning
 {
@@ -73,6 +84,10 @@ enum class ExecCMDWarning
 };
 std::string executeCmd(std::string const& _command, ExecCMDWarning _warningOnEmpty = ExecCMDWarning::WarningOnEmptyResult);
 
+/// run system command feeding _input to its stdin, return its stdout
+std::string executeCmdWithInput(std::string const& _command, std::string const& _input,
+    ExecCMDWarning _warningOnEmpty = ExecCMDWarning::WarningOnEmptyResult);
+
 // Return the vector of most looking like as _needles strings from the vector
 std::vector<std::string> levenshteinDistance(
     std::string const& _needle, std::vector<std::string> const& _sVec, size_t _max = 3);
@@ -121,6 +136,9 @@ enum popenOutput
 FILE* popen2(std::string const& _command, std::vector<std::string>const& _args, std::string const& _type, int& _pid, popenOutput _debug = popenOutput::DisableAll);
 int pclose2(FILE* _fp, pid_t _pid);
 
+/// wait up to _timeoutMS for the process to exit, true if it has exited
+bool waitProcessExit(pid_t _pid, size_t _timeoutMS);
+
 /// return path to the unique tmp directory
 fs::path createUniqueTmpDirectory();
 
@@ -135,19 +153,25 @@ string fto_string(t _val)
 class RLPStreamU
 {
 public:
-    RLPStreamU(size_t _size) : m_size(_size)
-    {
-        if (m_size > 1)
-            ETH_FAIL_MESSAGE("RLPStreamU does not support stream of multiple rlp items. It's a mock to wrap 1 transaction.");
-    }
+    RLPStreamU(size_t _size) : m_size(_size) {}
     void appendRaw(string const& _data);
     void appendString(string const& _data);
+
+    // List header and the string header of a single item stream
     string outHeader() const;
 
+    // Full list encoding of all appended items
+    string out() const;
+
 private:
-    bool m_wrapString = false;
+    struct Item
+    {
+        string const* data;
+        bool wrapString;
+    };
+    void append(string const& _data, bool _wrapString);
+    std::vector<Item> m_items;
     size_t m_size;
-    string const* m_data = 0;
 };
 
 }  // namespace test
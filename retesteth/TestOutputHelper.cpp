@@ -255,6 +255,9 @@ void TestOutputHelper::printTestExecStats()
         std::cout << setw(45) << "Total Time: " << setw(25) << "     : " + fto_string(totalTime) << "\n";
         for (size_t i = 0; i < execTimeResults.size(); i++)
             std::cout << setw(45) << execTimeResults[i].second << setw(25) << " time: " + fto_string(execTimeResults[i].first) << "\n";
+        CmdPathCacheStats const cmdStats = cmdPathCacheStats();
+        std::cout << setw(45) << "Command path lookups: " << setw(25) << "     : " + fto_string(cmdStats.resolved) << "\n";
+        std::cout << setw(45) << "Command path lookups saved: " << setw(25) << "     : " + fto_string(cmdStats.saved) << "\n";
         std::cout << "\n";
     }
     else
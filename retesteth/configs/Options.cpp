@@ -80,6 +80,10 @@ void Options::DynamicOptions::setCurrentConfig(ClientConfig const& _config)
     }
     ETH_FAIL_REQUIRE_MESSAGE(
         found, "_config not found in loaded options! (DynamicOptions::setCurrentConfig)");
+
+    // Client configs could bring their own tools, resolve commands again
+    if (m_currentConfigID != _config.getId())
+        resetCmdPathCache();
     m_currentConfigID = _config.getId();
 
     // Verify singleTestNet for the current config
@@ -3,6 +3,7 @@
 #include <AllTestNames.h>
 #include <retesteth/ExitHandler.h>
 #include <retesteth/Options.h>
+#include <retesteth/SpawnServer.h>
 #include <retesteth/testSuites/StateTests.h>
 #include <retesteth/testSuites/blockchain/BlockchainTests.h>
 #include <retesteth/testSuites/TransactionTest.h>
@@ -137,6 +138,9 @@ void setDefaultOrCLocale()
 int main(int argc, const char* argv[])
 {
     setDefaultOrCLocale();
+
+    // Fork the spawn server for tool/compiler processes while retesteth is still small
+    test::SpawnServer::start();
     signal(SIGABRT, &ExitHandler::exitHandler);
     signal(SIGTERM, &ExitHandler::exitHandler);
     signal(SIGINT, &ExitHandler::exitHandler);
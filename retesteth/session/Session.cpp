@@ -22,13 +22,20 @@
 
 #include "Session.h"
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <signal.h>
 #include <thread>
 #include <retesteth/EthChecks.h>
 #include <retesteth/Options.h>
 #include <retesteth/TestHelper.h>
 #include <retesteth/configs/ClientConfig.h>
 #include <retesteth/session/RPCImpl.h>
+#include <retesteth/session/Socket.h>
 #include <retesteth/session/ToolImpl.h>
+#include <retesteth/session/ToolLibImpl.h>
 #include <retesteth/ExitHandler.h>
 
 using namespace std;
@@ -45,23 +52,157 @@ struct sessionInfo
         pipePid = _pid;
         isUsed = RPCSession::NotExist;
         configId = _configId;
-        totalRuns = 0;
     }
     std::unique_ptr<RPCSession> session;
     std::unique_ptr<FILE> filePipe;
     int pipePid;
-    RPCSession::SessionStatus isUsed;
+    std::atomic<RPCSession::SessionStatus> isUsed;
+    std::atomic<thread::id> owner;  // thread that has the session checked out
     std::string tmpDir;
     test::ClientConfigID configId;
-    size_t totalRuns;
 };
+typedef std::shared_ptr<sessionInfo> spSessionInfo;
 
-void closeSession(thread::id const& _threadID);
+void closeSession(spSessionInfo const& _info);
 
-std::mutex g_socketMapMutex;
-static std::map<thread::id, sessionInfo> socketMap;
+namespace
+{
+// Session pool. Threads check sessions out and back in, the mutex only guards the bookkeeping
+// and is never held while a client is starting
+std::mutex g_sessionPoolMutex;
+std::map<thread::id, spSessionInfo> g_busySessions;  // checked out sessions
+std::vector<spSessionInfo> g_idleSessions;           // checked in sessions, could be reused
+size_t g_startingSessions = 0;                       // clients being started outside of the mutex
+
+// Session of this thread. Valid while the session owner is this thread
+thread_local spSessionInfo t_session;
+
+// Test runs of the current configuration since the clients were started
+std::atomic<size_t> g_currentCfgTestRuns{0};
+
+// Start script is run once after the clients were stopped
+std::mutex g_startScriptMutex;
+bool g_startScriptDone = false;
+
+// Return the session checked out by _threadID or null
+spSessionInfo findSession(thread::id const& _threadID)
+{
+    bool const thisThread = _threadID == std::this_thread::get_id();
+    if (thisThread && t_session && t_session->owner.load() == _threadID)
+        return t_session;
+
+    std::lock_guard<std::mutex> lock(g_sessionPoolMutex);
+    auto const it = g_busySessions.find(_threadID);
+    if (it == g_busySessions.end())
+        return spSessionInfo();
+    if (thisThread)
+        t_session = it->second;
+    return it->second;
+}
+
+// Probe the client with web3_clientVersion until it is _ready (or down), doubling the delay between probes
+bool waitForClient(Socket::SocketType _type, string const& _path, bool _ready, size_t _timeoutMS)
+{
+    static string const c_probe = "{\"jsonrpc\":\"2.0\",\"method\":\"web3_clientVersion\",\"params\":[],\"id\":0}";
+    auto const deadline = chrono::steady_clock::now() + chrono::milliseconds(_timeoutMS);
+    size_t delayMS = 50;
+    while (!ExitHandler::receivedExitSignal())
+    {
+        if (Socket::probe(_type, _path, c_probe, 1000) == _ready)
+            return true;
+        auto const now = chrono::steady_clock::now();
+        if (now >= deadline)
+            return false;
+        this_thread::sleep_for(min(chrono::milliseconds(delayMS),
+            chrono::duration_cast<chrono::milliseconds>(deadline - now)));
+        delayMS = min<size_t>(delayMS * 2, 2000);
+    }
+    return false;
+}
+
+// Probe the tcp nodes of the config concurrently
+bool waitForNodes(ClientConfig const& _config, bool _ready, size_t _timeoutMS)
+{
+    std::vector<IPADDRESS> const& addresses = _config.cfgFile().socketAdresses();
+    size_t const nodes = min(addresses.size(), Options::get().threadCount);
+    std::vector<char> results(nodes, 0);
+    std::vector<thread> probes;
+    for (size_t i = 0; i < nodes; i++)
+        probes.emplace_back([&addresses, &results, i, _ready, _timeoutMS]() {
+            results.at(i) = waitForClient(Socket::SocketType::TCP, addresses.at(i).asString(), _ready, _timeoutMS);
+        });
+    for (auto& th : probes)
+        th.join();
+    return std::all_of(results.begin(), results.end(), [](char _res) { return _res != 0; });
+}
+
+// Register the session as checked out by _threadID. Called under the pool mutex
+void checkOut(thread::id const& _threadID, spSessionInfo const& _info)
+{
+    _info->owner = _threadID;
+    _info->isUsed = RPCSession::SessionStatus::Working;
+    g_busySessions[_threadID] = _info;
+    if (_threadID == std::this_thread::get_id())
+        t_session = _info;
+}
+}  // namespace
 
 void RPCSession::runNewInstanceOfAClient(thread::id const& _threadID, ClientConfig const& _config)
+{
+    if (_config.cfgFile().socketType() == ClientConfgSocketType::TCP)
+    {
+        Options const& opt = Options::get();
+        std::vector<IPADDRESS> const& ports =
+            (opt.nodesoverride.size() > 0 ? opt.nodesoverride : _config.cfgFile().socketAdresses());
+
+        // Create sessionInfo for a tcp address that is still not present in the pool
+        // Nothing is started here, so the address is picked under the pool mutex
+        std::lock_guard<std::mutex> lock(g_sessionPoolMutex);
+        auto const usesAddress = [](spSessionInfo const& _info, IPADDRESS const& _addr) {
+            return _info->session.get()->getImplementation().getSocketPath() == _addr.asString();
+        };
+        for (auto const& addr : ports)
+        {
+            bool unused = true;
+            for (auto const& socket : g_busySessions)
+                unused = unused && !usesAddress(socket.second, addr);
+            for (auto const& socket : g_idleSessions)
+                unused = unused && !usesAddress(socket, addr);
+            if (unused)
+            {
+                spSessionInfo info(new sessionInfo(
+                    NULL, new RPCSession(new RPCImpl(Socket::SocketType::TCP, addr.asString())), "", 0, _config.getId()));
+                ETH_LOG("addr: " + addr.asString(), 2);
+                checkOut(_threadID, info);
+                return;
+            }
+        }
+        return;
+    }
+
+    // The client is started outside of the pool mutex, so one slow start does not block other threads
+    {
+        std::lock_guard<std::mutex> lock(g_sessionPoolMutex);
+        g_startingSessions++;
+    }
+    spSessionInfo info;
+    try
+    {
+        info = startNewInstanceOfAClient(_config);
+    }
+    catch (...)
+    {
+        std::lock_guard<std::mutex> lock(g_sessionPoolMutex);
+        g_startingSessions--;
+        throw;
+    }
+
+    std::lock_guard<std::mutex> lock(g_sessionPoolMutex);
+    g_startingSessions--;
+    checkOut(_threadID, info);
+}
+
+spSessionInfo RPCSession::startNewInstanceOfAClient(ClientConfig const& _config)
 {
     switch (_config.cfgFile().socketType())
     {
@@ -87,49 +228,13 @@ void RPCSession::runNewInstanceOfAClient(thread::id const& _threadID, ClientConf
         }
         else
         {
-            int maxSeconds = 25;
-            while (!boost::filesystem::exists(ipcPath) && maxSeconds-- > 0)
-                std::this_thread::sleep_for(std::chrono::seconds(1));
-            ETH_FAIL_REQUIRE_MESSAGE(maxSeconds > 0, "Client took too long to start ipc!");
-            // Client has opened ipc socket. wait for it to initialize
-            ClientConfig const& curCFG = Options::getDynamicOptions().getCurrentConfig();
-            size_t const initTime = curCFG.cfgFile().initializeTime();
-            std::this_thread::sleep_for(std::chrono::seconds(initTime));
+            // Wait until the client answers on the ipc socket, but no longer than it used to take to initialize
+            size_t const maxSeconds = 25 + _config.cfgFile().initializeTime();
+            bool const ready = waitForClient(Socket::SocketType::IPC, ipcPath, true, maxSeconds * 1000);
+            ETH_FAIL_REQUIRE_MESSAGE(ready || ExitHandler::receivedExitSignal(), "Client took too long to start ipc!");
         }
-        sessionInfo info(
-            fp, new RPCSession(new RPCImpl(Socket::SocketType::IPC, ipcPath)), tmpDir.string(), pid, _config.getId());
-        socketMap.insert(std::pair<thread::id, sessionInfo>(_threadID, std::move(info)));
-        break;
-    }
-    case ClientConfgSocketType::TCP:
-    {
-        Options const& opt = Options::get();
-        std::vector<IPADDRESS> const& ports =
-            (opt.nodesoverride.size() > 0 ? opt.nodesoverride : _config.cfgFile().socketAdresses());
-
-        // Create sessionInfo for a tcp address that is still not present in socketMap
-        for (auto const& addr : ports)
-        {
-            bool unused = true;
-            for (auto const& socket : socketMap)
-            {
-                sessionInfo const& sInfo = socket.second;
-                if (sInfo.session.get()->getImplementation().getSocketPath() == addr.asString())
-                {
-                    unused = false;
-                    break;
-                }
-            }
-            if (unused)
-            {
-                sessionInfo info(
-                    NULL, new RPCSession(new RPCImpl(Socket::SocketType::TCP, addr.asString())), "", 0, _config.getId());
-                ETH_LOG("addr: " + addr.asString(), 2);
-                socketMap.insert(std::pair<thread::id, sessionInfo>(_threadID, std::move(info)));
-                return;
-            }
-        }
-        break;
+        return spSessionInfo(new sessionInfo(
+            fp, new RPCSession(new RPCImpl(Socket::SocketType::IPC, ipcPath)), tmpDir.string(), pid, _config.getId()));
     }
     case ClientConfgSocketType::IPCDebug:
     {
@@ -138,49 +243,39 @@ void RPCSession::runNewInstanceOfAClient(thread::id const& _threadID, ClientConf
         fs::path const& ipcPath = _config.cfgFile().path();
         int pid = 0;
         FILE* fp = NULL;
-        sessionInfo info(
-            fp, new RPCSession(new RPCImpl(Socket::SocketType::IPC, ipcPath.string())), tmpDir.string(), pid, _config.getId());
-        socketMap.insert(std::pair<thread::id, sessionInfo>(_threadID, std::move(info)));
-        break;
+        return spSessionInfo(new sessionInfo(
+            fp, new RPCSession(new RPCImpl(Socket::SocketType::IPC, ipcPath.string())), tmpDir.string(), pid, _config.getId()));
     }
 
     case ClientConfgSocketType::TransitionTool:
     {
         fs::path tmpDir = test::createUniqueTmpDirectory();
-        sessionInfo info(NULL, new RPCSession(new ToolImpl(Socket::SocketType::TCP, _config.cfgFile().shell(), tmpDir)),
-            tmpDir.string(), 0, _config.getId());
-        socketMap.insert(std::pair<thread::id, sessionInfo>(_threadID, std::move(info)));
-        break;
+        return spSessionInfo(
+            new sessionInfo(NULL, new RPCSession(new ToolImpl(Socket::SocketType::TCP, _config.cfgFile().shell(), tmpDir)),
+                tmpDir.string(), 0, _config.getId()));
+    }
+    case ClientConfgSocketType::TransitionLibrary:
+    {
+        fs::path tmpDir = test::createUniqueTmpDirectory();
+        return spSessionInfo(new sessionInfo(
+            NULL, new RPCSession(new ToolLibImpl(_config.cfgFile().shell(), tmpDir)), tmpDir.string(), 0, _config.getId()));
     }
     default:
         ETH_FAIL_MESSAGE("Unknown Socket Type in runNewInstanceOfAClient");
     }
+    return spSessionInfo();
 }
 
 void RPCSession::currentCfgCountTestRun()
 {
-    std::lock_guard<std::mutex> lock(g_socketMapMutex);
-    ClientConfig const& curCFG = Options::getDynamicOptions().getCurrentConfig();
-    for (auto& el : socketMap)
-    {
-        sessionInfo& info = el.second;
-        if (info.configId.id() == curCFG.getId().id())
-            info.totalRuns++;
-    }
+    // Sessions are all opened for the current config, clear() resets the counter on the config switch
+    g_currentCfgTestRuns++;
 }
 
 bool RPCSession::isRunningTooLong()
 {
     static const size_t c_maxTestBeforeFlush = 1500;
-    std::lock_guard<std::mutex> lock(g_socketMapMutex);
-    ClientConfig const& curCFG = Options::getDynamicOptions().getCurrentConfig();
-    for (auto const& el : socketMap)
-    {
-        sessionInfo const& info = el.second;
-         if (info.configId.id() == curCFG.getId().id() && info.totalRuns > c_maxTestBeforeFlush)
-             return true;
-    }
-    return false;
+    return g_currentCfgTestRuns.load() > c_maxTestBeforeFlush;
 }
 
 void RPCSession::restartScripts(bool _stop)
@@ -214,114 +309,138 @@ void RPCSession::restartScripts(bool _stop)
     }
 
     // If there are no clients started with this configuration, run the start script
-    // Assume here that socketMap is open for single configuration at a time only
-    if (socketMap.empty())
-    {
-        if (!fs::exists(curCFG.getStartScript()))
-            return;
+    // Only threads that open a new session wait here while the clients are starting
+    std::lock_guard<std::mutex> lock(g_startScriptMutex);
+    if (g_startScriptDone)
+        return;
+    g_startScriptDone = true;
 
-        size_t const threads = Options::get().threadCount;
-        string const start = curCFG.getStartScript().c_str();
-        auto cmd = [](string const& _cmd, string const& _args) {
-            test::executeCmd(_cmd + " " + _args, ExecCMDWarning::NoWarning);
-        };
-        switch (curCFG.cfgFile().socketType())
-        {
-        case ClientConfgSocketType::TCP:
-        {
-            thread task(cmd, start, test::fto_string(threads) + " 2>/dev/null");
-            ETH_LOG(start, 1);
-            task.detach();
-            size_t const initTime = curCFG.cfgFile().initializeTime();
-            size_t const seconds = Options::get().lowcpu ? initTime * 5 : initTime;
-            this_thread::sleep_for(chrono::seconds(seconds));
-        }
+    if (!fs::exists(curCFG.getStartScript()))
+        return;
+
+    size_t const threads = Options::get().threadCount;
+    string const start = curCFG.getStartScript().c_str();
+    auto cmd = [](string const& _cmd, string const& _args) {
+        test::executeCmd(_cmd + " " + _args, ExecCMDWarning::NoWarning);
+    };
+    switch (curCFG.cfgFile().socketType())
+    {
+    case ClientConfgSocketType::TCP:
+    {
+        thread task(cmd, start, test::fto_string(threads) + " 2>/dev/null");
+        ETH_LOG(start, 1);
+        task.detach();
+        size_t const initTime = curCFG.cfgFile().initializeTime();
+        size_t const seconds = 25 + (Options::get().lowcpu ? initTime * 5 : initTime);
+        if (!waitForNodes(curCFG, true, seconds * 1000) && !ExitHandler::receivedExitSignal())
+            ETH_WARNING("Not all nodes started by `" + start + "` answer after " + test::fto_string(seconds) + " seconds");
+    }
+    break;
+    default:
         break;
-        default:
-            break;
-        }
     }
 }
 
 SessionInterface& RPCSession::instance(thread::id const& _threadID)
 {
-    std::lock_guard<std::mutex> lock(g_socketMapMutex);
-    bool needToCreateNew = false;
     test::ClientConfigID currentConfigId = Options::getDynamicOptions().getCurrentConfig().getId();
-    if (socketMap.count(_threadID) && socketMap.at(_threadID).configId != currentConfigId)
+    spSessionInfo session = findSession(_threadID);
+    if (session)
     {
         // For this thread a session is opened but it is opened not for current tested client
-        ETH_FAIL_MESSAGE("A session opened for another client id!");
+        if (session->configId != currentConfigId)
+            ETH_FAIL_MESSAGE("A session opened for another client id!");
+        return session->session.get()->getImplementation();
     }
 
     // If there are no clients running, instantiate them with starter scripts
     restartScripts();
 
-    if (!socketMap.count(_threadID))
     {
         // look for free clients that already instantiated
-        for (auto& socket : socketMap)
+        std::lock_guard<std::mutex> lock(g_sessionPoolMutex);
+        for (auto it = g_idleSessions.begin(); it != g_idleSessions.end(); it++)
         {
-            if (socket.second.isUsed == SessionStatus::Available)
-                if (socket.second.configId == currentConfigId)
-                {
-                    socket.second.isUsed = SessionStatus::Working;
-                    socketMap.insert(std::pair<thread::id, sessionInfo>(_threadID, std::move(socket.second)));
-                    socketMap.erase(socketMap.find(socket.first));  // remove previous threadID assigment to this socket
-                    assert(socketMap.count(_threadID));
-                    return socketMap.at(_threadID).session.get()->getImplementation();
-                }
+            if ((*it)->configId == currentConfigId)
+            {
+                spSessionInfo const info = *it;
+                g_idleSessions.erase(it);
+                checkOut(_threadID, info);
+                return info->session.get()->getImplementation();
+            }
         }
-        needToCreateNew = true;
-    }
-    if (needToCreateNew)
-    {
-        size_t const threadID = std::hash<std::thread::id>()(_threadID);
-        ETH_LOG("Run new connection session for `" + test::fto_string(threadID) + "`", 2);
-        runNewInstanceOfAClient(_threadID, Options::getDynamicOptions().getCurrentConfig());
-        ETH_LOG("New instance started", 2);
     }
 
-    ETH_FAIL_REQUIRE_MESSAGE(socketMap.size() <= Options::get().threadCount,
-        "Something went wrong. Retesteth connect to more instances than needed!");
-    ETH_FAIL_REQUIRE_MESSAGE(socketMap.size() != 0, "Something went wrong. Retesteth failed to create socket connection!");
     size_t const threadID = std::hash<std::thread::id>()(_threadID);
+    ETH_LOG("Run new connection session for `" + test::fto_string(threadID) + "`", 2);
+    runNewInstanceOfAClient(_threadID, Options::getDynamicOptions().getCurrentConfig());
+    ETH_LOG("New instance started", 2);
+
+    std::lock_guard<std::mutex> lock(g_sessionPoolMutex);
+    size_t const sessions = g_busySessions.size() + g_idleSessions.size() + g_startingSessions;
     ETH_FAIL_REQUIRE_MESSAGE(
-        socketMap.count(_threadID), "ThreadID: `" + fto_string(threadID) + "` not registered in socketMap!");
-    return socketMap.at(_threadID).session.get()->getImplementation();
+        sessions <= Options::get().threadCount, "Something went wrong. Retesteth connect to more instances than needed!");
+    ETH_FAIL_REQUIRE_MESSAGE(sessions != 0, "Something went wrong. Retesteth failed to create socket connection!");
+    auto const it = g_busySessions.find(_threadID);
+    ETH_FAIL_REQUIRE_MESSAGE(
+        it != g_busySessions.end(), "ThreadID: `" + fto_string(threadID) + "` not registered in session pool!");
+    return it->second->session.get()->getImplementation();
 }
 
 void RPCSession::sessionStart(thread::id const& _threadID)
 {
     RPCSession::instance(_threadID);  // initialize the client if not exist
-    std::lock_guard<std::mutex> lock(g_socketMapMutex);
-    if (socketMap.count(_threadID))
-        socketMap.at(_threadID).isUsed = SessionStatus::Working;
+    spSessionInfo const session = findSession(_threadID);
+    if (session)
+        session->isUsed = SessionStatus::Working;
 }
 
 void RPCSession::sessionEnd(thread::id const& _threadID, SessionStatus _status)
 {
-    std::lock_guard<std::mutex> lock(g_socketMapMutex);
-    if (socketMap.count(_threadID))
-        socketMap.at(_threadID).isUsed = _status;
+    spSessionInfo const session = findSession(_threadID);
+    if (!session)
+        return;
+    session->isUsed = _status;
+    if (_status != SessionStatus::Available)
+        return;
+
+    // Check the session back into the pool so that any thread could take it
+    std::lock_guard<std::mutex> lock(g_sessionPoolMutex);
+    auto const it = g_busySessions.find(_threadID);
+    if (it == g_busySessions.end() || it->second != session)
+        return;
+    g_busySessions.erase(it);
+    session->owner = thread::id();
+    g_idleSessions.push_back(session);
+    if (_threadID == std::this_thread::get_id())
+        t_session.reset();
 }
 
 RPCSession::SessionStatus RPCSession::sessionStatus(thread::id const& _threadID)
 {
-    std::lock_guard<std::mutex> lock(g_socketMapMutex);
-    if (socketMap.count(_threadID))
-        return socketMap.at(_threadID).isUsed;
+    spSessionInfo const session = findSession(_threadID);
+    if (session)
+        return session->isUsed;
     return RPCSession::NotExist;
 }
 
-void closeSession(thread::id const& _threadID)
+void closeSession(spSessionInfo const& _info)
 {
-    ETH_FAIL_REQUIRE_MESSAGE(socketMap.count(_threadID), "Socket map is empty in closeSession!");
-    sessionInfo& element = socketMap.at(_threadID);
+    sessionInfo& element = *_info;
     if (element.session.get()->getImplementation().getSocketType() == Socket::SocketType::IPC)
     {
         test::pclose2(element.filePipe.get(), element.pipePid);
-        std::this_thread::sleep_for(std::chrono::seconds(4));
+        if (element.pipePid > 0)
+        {
+            // The client is a child of the start script shell. popen2 makes the shell a group leader,
+            // stop the whole group so that the client does not keep the socket in tmpDir
+            kill(-element.pipePid, SIGTERM);
+            if (!test::waitProcessExit(element.pipePid, 4000))
+                ETH_LOG("Client process " + test::fto_string(element.pipePid) + " has not exited in 4 seconds", 2);
+            string const& ipcPath = element.session.get()->getImplementation().getSocketPath();
+            if (!waitForClient(Socket::SocketType::IPC, ipcPath, false, 4000) && !ExitHandler::receivedExitSignal())
+                ETH_LOG("Client still answers on " + ipcPath + " after 4 seconds", 2);
+        }
         boost::filesystem::remove_all(boost::filesystem::path(element.tmpDir));
         element.filePipe.release();
         element.session.release();
@@ -330,18 +449,35 @@ void closeSession(thread::id const& _threadID)
 
 void RPCSession::clear()
 {
+    // Take all sessions out of the pool, then close them without holding the pool mutex
+    std::vector<spSessionInfo> sessions;
+    {
+        std::lock_guard<std::mutex> lock(g_sessionPoolMutex);
+        for (auto& element : g_busySessions)
+            sessions.push_back(element.second);
+        for (auto& element : g_idleSessions)
+            sessions.push_back(element);
+        g_busySessions.clear();
+        g_idleSessions.clear();
+        for (auto& element : sessions)
+            element->owner = thread::id();
+        g_currentCfgTestRuns = 0;
+    }
+    t_session.reset();
+    {
+        std::lock_guard<std::mutex> lock(g_startScriptMutex);
+        g_startScriptDone = false;
+    }
+
     // Close all active connection listeners
-    std::lock_guard<std::mutex> lock(g_socketMapMutex);
     std::vector<thread> closingThreads;
-    for (auto& element : socketMap)
+    for (auto const& element : sessions)
     {
-        thread t(closeSession, element.first);
+        thread t(closeSession, element);
         closingThreads.push_back(std::move(t));
     }
     for (auto& th : closingThreads)
         th.join();
-
-    socketMap.clear();
     closingThreads.clear();
 
     // If not running UnitTests or smth
@@ -352,14 +488,67 @@ void RPCSession::clear()
         {
             executeCmd(curCFG.getStopperScript().c_str(), ExecCMDWarning::NoWarningNoError);
             ETH_LOG(curCFG.getStopperScript().c_str(), 1);
-            if (!ExitHandler::receivedExitSignal())
+
+            // Ipc clients are confirmed down by their pid. Wait for the tcp nodes to stop answering
+            if (!ExitHandler::receivedExitSignal() && curCFG.cfgFile().socketType() == ClientConfgSocketType::TCP)
             {
                 size_t const initTime = curCFG.cfgFile().initializeTime();
                 size_t const seconds = Options::get().lowcpu ? initTime + 10 : initTime;
-                this_thread::sleep_for(chrono::seconds(seconds));
+                waitForNodes(curCFG, false, seconds * 1000);
             }
         }
     }
 }
 
+void RPCSession::warmUp(size_t _clients)
+{
+    ClientConfig const& curCFG = Options::getDynamicOptions().getCurrentConfig();
+
+    // If there are no clients running, instantiate them with starter scripts
+    restartScripts();
+    switch (curCFG.cfgFile().socketType())
+    {
+    case ClientConfgSocketType::IPC:
+    case ClientConfgSocketType::TransitionTool:
+    case ClientConfgSocketType::TransitionLibrary:
+        break;
+    default:
+        return;
+    }
+
+    size_t missing = 0;
+    {
+        std::lock_guard<std::mutex> lock(g_sessionPoolMutex);
+        size_t const sessions = g_busySessions.size() + g_idleSessions.size() + g_startingSessions;
+        missing = _clients > sessions ? _clients - sessions : 0;
+        g_startingSessions += missing;
+    }
+
+    // Start the clients concurrently and leave them in the pool for the workers
+    std::vector<thread> startingThreads;
+    for (size_t i = 0; i < missing; i++)
+        startingThreads.emplace_back([&curCFG]() {
+            spSessionInfo info;
+            try
+            {
+                if (!ExitHandler::receivedExitSignal())
+                    info = startNewInstanceOfAClient(curCFG);
+            }
+            catch (std::exception const& _ex)
+            {
+                ETH_LOG(string("Client warm up failed: ") + _ex.what(), 2);
+            }
+            std::lock_guard<std::mutex> lock(g_sessionPoolMutex);
+            g_startingSessions--;
+            if (info)
+            {
+                info->isUsed = SessionStatus::Available;
+                g_idleSessions.push_back(info);
+            }
+        });
+    for (auto& th : startingThreads)
+        th.join();
+    ETH_LOG("Warmed up " + test::fto_string(missing) + " client sessions", 2);
+}
+
 RPCSession::RPCSession(SessionInterface* _impl) : m_implementation(_impl) {}
@@ -4,6 +4,7 @@
 #include <boost/noncopyable.hpp>
 #include <boost/test/unit_test.hpp>
 #include <map>
+#include <memory>
 #include <string>
 #include <thread>
 
@@ -12,8 +13,11 @@
 #include <retesteth/session/SessionInterface.h>
 
 using namespace dataobject;
+struct sessionInfo;
 
 // Session connections to an instance of a client
+// Sessions are kept in a pool. A thread checks a session out on first use and checks it back in
+// when the session becomes Available
 class RPCSession : public boost::noncopyable
 {
 public:
@@ -31,6 +35,9 @@ public:
     static SessionStatus sessionStatus(thread::id const& _threadID);
     static void clear();
 
+    // Start _clients clients concurrently before the tests ask for them
+    static void warmUp(size_t _clients);
+
     // Flush the memory by restarting the clients with configuration scripts
     static void currentCfgCountTestRun();            // Increase test run counter
     static bool isRunningTooLong();                  // True if running connection for tool long
@@ -42,5 +49,6 @@ public:
 private:
     explicit RPCSession(SessionInterface* _impl);
     static void runNewInstanceOfAClient(thread::id const& _threadID, test::ClientConfig const& _config);
+    static std::shared_ptr<sessionInfo> startNewInstanceOfAClient(test::ClientConfig const& _config);
     SessionInterface* m_implementation;
 };
@@ -34,6 +34,23 @@ private:
     bool m_empty;
 };
 
+// Parent block and current block parameters of a difficulty calculation
+struct DifficultyRequest
+{
+    spVALUE blockNumber;
+    spVALUE parentTimestamp;
+    spVALUE parentDifficulty;
+    spVALUE currentTimestamp;
+    spVALUE uncleNumber;
+};
+
+// Transaction rlp validated on a fork
+struct RawTransactionRequest
+{
+    spBYTES rlp;
+    spFORK fork;
+};
+
 class SessionInterface
 {
 public:
@@ -71,9 +88,30 @@ public:
     virtual FH32 test_importRawBlock(BYTES const& _blockRLP) = 0;
     virtual FH32 test_getLogHash(FH32 const& _txHash) = 0;
     virtual TestRawTransaction test_rawTransaction(BYTES const& _rlp, FORK const& _fork) = 0;
+
+    // Results in the order of requests. Clients without batch support validate transactions one by one
+    virtual std::vector<TestRawTransaction> test_rawTransactionBatch(std::vector<RawTransactionRequest> const& _requests)
+    {
+        std::vector<TestRawTransaction> res;
+        for (auto const& el : _requests)
+            res.push_back(test_rawTransaction(el.rlp, el.fork));
+        return res;
+    }
     virtual VALUE test_calculateDifficulty(FORK const& _fork, VALUE const& _blockNumber, VALUE const& _parentTimestamp,
         VALUE const& _parentDifficulty, VALUE const& _currentTimestamp, VALUE const& _uncleNumber) = 0;
 
+    // Difficulty of all vectors of a fork, used when filling the tests
+    // Clients without batch support calculate vectors one by one
+    virtual std::vector<spVALUE> test_calculateDifficultyBatch(
+        FORK const& _fork, std::vector<DifficultyRequest> const& _requests)
+    {
+        std::vector<spVALUE> res;
+        for (auto const& el : _requests)
+            res.push_back(spVALUE(new VALUE(test_calculateDifficulty(_fork, el.blockNumber, el.parentTimestamp,
+                el.parentDifficulty, el.currentTimestamp, el.uncleNumber))));
+        return res;
+    }
+
     // Internal
     virtual spDataObject rpcCall(std::string const& _methodName,
         std::vector<std::string> const& _args = std::vector<std::string>(),
@@ -1,5 +1,8 @@
 #include "Socket.h"
 #include <curl/curl.h>
+#include <chrono>
+#include <cstring>
+#include <unistd.h>
 #include <retesteth/EthChecks.h>
 #include <retesteth/ExitHandler.h>
 
@@ -185,8 +188,81 @@ string sendRequestTCP(string const& _req, string const& _address)
         ETH_FAIL_MESSAGE("Error initializing Curl");
     return string();
 }
+
+bool probeTCP(string const& _req, string const& _address, unsigned _timeoutMS)
+{
+    CURL* curl = curl_easy_init();
+    if (!curl)
+        return false;
+
+    string url = _address;
+    if (_address.find("http") == string::npos)
+        url = "http://" + _address;
+    string reply;
+    curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
+    curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, writecallback);
+    curl_easy_setopt(curl, CURLOPT_WRITEDATA, &reply);
+    curl_easy_setopt(curl, CURLOPT_POSTFIELDS, _req.c_str());
+
+    struct curl_slist* header = NULL;
+    header = curl_slist_append(header, "Content-Type: application/json");
+    curl_easy_setopt(curl, CURLOPT_HTTPHEADER, header);
+    curl_easy_setopt(curl, CURLOPT_CONNECTTIMEOUT_MS, (long)_timeoutMS);
+    curl_easy_setopt(curl, CURLOPT_TIMEOUT_MS, (long)_timeoutMS);
+    CURLcode const res = curl_easy_perform(curl);
+    curl_slist_free_all(header);
+    curl_easy_cleanup(curl);
+    return res == CURLE_OK && reply.find("\"result\"") != string::npos;
+}
+
+bool probeIPC(string const& _req, string const& _path, unsigned _timeoutMS)
+{
+    if (_path.length() >= sizeof(sockaddr_un::sun_path))
+        return false;
+    struct sockaddr_un saun;
+    memset(&saun, 0, sizeof(sockaddr_un));
+    saun.sun_family = AF_UNIX;
+    strcpy(saun.sun_path, _path.c_str());
+#if defined(__APPLE__)
+    saun.sun_len = sizeof(struct sockaddr_un);
+#endif
+
+    int const sock = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (sock < 0)
+        return false;
+    struct timeval tv;
+    tv.tv_sec = _timeoutMS / 1000;
+    tv.tv_usec = (_timeoutMS % 1000) * 1000;
+    setsockopt(sock, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+    setsockopt(sock, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv));
+
+    JsonObjectValidator validator;
+    if (connect(sock, reinterpret_cast<struct sockaddr const*>(&saun), sizeof(struct sockaddr_un)) == 0 &&
+        send(sock, _req.c_str(), _req.length(), 0) == (ssize_t)_req.length())
+    {
+        char buf[4096];
+        auto const start = chrono::steady_clock::now();
+        while (!validator.completeResponse() &&
+               chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - start).count() < _timeoutMS)
+        {
+            ssize_t const ret = recv(sock, buf, sizeof(buf), 0);
+            if (ret <= 0)
+                break;
+            validator.acceptResponse(string(buf, ret));
+        }
+    }
+    close(sock);
+    return validator.completeResponse() && validator.getResponse().find("\"result\"") != string::npos;
+}
 }  // namespace
 
+bool Socket::probe(SocketType _type, string const& _path, string const& _req, unsigned _timeoutMS)
+{
+    if (_type == Socket::TCP)
+        return probeTCP(_req, _path, _timeoutMS);
+    return probeIPC(_req, _path, _timeoutMS);
+}
+
 string Socket::sendRequestIPC(string const& _req, SocketResponseValidator& _validator)
 {
     char buf;
@@ -63,6 +63,9 @@ public:
     std::string sendRequest(std::string const& _req, SocketResponseValidator& _responseValidator);
     ~Socket() { close(m_socket); }
 
+    // Send _req to the client without failing the test. True if the client has replied with a result in _timeoutMS
+    static bool probe(SocketType _type, std::string const& _path, std::string const& _req, unsigned _timeoutMS);
+
     std::string const& path() const { return m_path; }
     SocketType type() const { return m_socketType; }
 
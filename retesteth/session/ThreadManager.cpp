@@ -3,13 +3,244 @@
 #include <retesteth/Options.h>
 #include <retesteth/ExitHandler.h>
 #include <condition_variable>
+#include <deque>
+#include <limits>
+#include <memory>
 
-size_t g_activejobs = 0;
-std::mutex g_jobsmutex;
-std::condition_variable g_cv;
-std::mutex g_callbackmutex;
 unsigned int ThreadManager::currConfigId = 0;
-map<thread::id, thread> ThreadManager::threadMap;
+
+namespace
+{
+size_t const c_notAWorker = std::numeric_limits<size_t>::max();
+thread_local size_t t_workerIndex = c_notAWorker;
+
+// Sub jobs of one runSubTasks call. Workers that pick up the group take the jobs one by one
+class SubTaskGroup
+{
+public:
+    SubTaskGroup(std::vector<std::function<void()>> const& _jobs)
+      : m_jobs(_jobs), m_errors(_jobs.size()), m_size(_jobs.size())
+    {}
+
+    // Execute jobs of the group until there are none left
+    void work()
+    {
+        size_t i = 0;
+        while (claim(i))
+        {
+            std::exception_ptr error;
+            try
+            {
+                m_jobs.at(i)();
+            }
+            catch (...)
+            {
+                // EthError message is stored at TestOutputHelper of this thread
+                error = std::current_exception();
+            }
+            finish(i, error);
+        }
+    }
+
+    // Wait for the jobs taken by other workers
+    void wait()
+    {
+        std::unique_lock<std::mutex> lk(m_mutex);
+        m_cv.wait(lk, [this]() { return m_running == 0 && (m_failed || m_next >= m_size); });
+    }
+
+    std::vector<std::exception_ptr> const& errors() const { return m_errors; }
+
+private:
+    bool claim(size_t& _index)
+    {
+        // Same as sequential execution, do not start the next jobs after a failure
+        std::lock_guard<std::mutex> lk(m_mutex);
+        if (m_failed || m_next >= m_size)
+            return false;
+        _index = m_next++;
+        m_running++;
+        return true;
+    }
+
+    void finish(size_t _index, std::exception_ptr const& _error)
+    {
+        std::lock_guard<std::mutex> lk(m_mutex);
+        m_errors.at(_index) = _error;
+        if (_error)
+            m_failed = true;
+        m_running--;
+        m_cv.notify_all();
+    }
+
+    // Valid while the caller of runSubTasks waits for the group
+    std::vector<std::function<void()>> const& m_jobs;
+    std::vector<std::exception_ptr> m_errors;
+    size_t const m_size;
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    size_t m_next = 0;
+    size_t m_running = 0;
+    bool m_failed = false;
+};
+
+// Persistent worker threads. Each worker has its own task queue, it takes tasks from the front of it
+// An idle worker steals tasks from the back of the queues of other workers,
+// so sub jobs pushed by a busy worker are picked up by the idle ones first.
+// Tasks are test files or sub jobs, so a single mutex for all queues is not a bottleneck
+class WorkerPool
+{
+public:
+    static WorkerPool& get()
+    {
+        static WorkerPool pool;
+        return pool;
+    }
+
+    // Start _count workers, stop the old ones if the number is different
+    // Called from the main thread only
+    void start(size_t _count)
+    {
+        if (m_threads.size() == _count)
+            return;
+        stop();
+        std::lock_guard<std::mutex> lk(m_mutex);
+        m_queues.resize(_count);
+        for (size_t i = 0; i < _count; i++)
+            m_threads.emplace_back(&WorkerPool::work, this, i);
+    }
+
+    // Let the workers finish all tasks and join them
+    void stop()
+    {
+        {
+            std::lock_guard<std::mutex> lk(m_mutex);
+            m_stop = true;
+        }
+        m_taskCV.notify_all();
+        for (auto& th : m_threads)
+            th.join();
+        m_threads.clear();
+        std::lock_guard<std::mutex> lk(m_mutex);
+        m_queues.clear();
+        m_stop = false;
+    }
+
+    // Queue a task to a worker. Wait while every worker has a task queued so that
+    // the caller does not run ahead of the execution
+    void addTask(std::function<void()> const& _task)
+    {
+        std::unique_lock<std::mutex> lk(m_mutex);
+        m_stateCV.wait(lk, [this]() { return m_queued < m_queues.size(); });
+        m_queues.at(m_nextQueue++ % m_queues.size()).push_back(_task);
+        m_queued++;
+        lk.unlock();
+        m_taskCV.notify_one();
+    }
+
+    // Queue a task to the queue of the calling worker
+    void addLocalTasks(std::function<void()> const& _task, size_t _count)
+    {
+        {
+            std::lock_guard<std::mutex> lk(m_mutex);
+            size_t const queue = t_workerIndex == c_notAWorker ? m_nextQueue++ % m_queues.size() : t_workerIndex;
+            for (size_t i = 0; i < _count; i++)
+                m_queues.at(queue).push_back(_task);
+            m_queued += _count;
+        }
+        m_taskCV.notify_all();
+    }
+
+    // Wait until all queued tasks are finished
+    void join()
+    {
+        std::unique_lock<std::mutex> lk(m_mutex);
+        m_stateCV.wait(lk, [this]() { return m_queued == 0 && m_running == 0; });
+    }
+
+    size_t size()
+    {
+        std::lock_guard<std::mutex> lk(m_mutex);
+        return m_queues.size();
+    }
+
+private:
+    WorkerPool() {}
+
+    void work(size_t _index)
+    {
+        t_workerIndex = _index;
+        while (true)
+        {
+            std::function<void()> task;
+            {
+                std::unique_lock<std::mutex> lk(m_mutex);
+                m_taskCV.wait(lk, [this]() { return m_stop || m_queued > 0; });
+                if (m_queued == 0)
+                    break;
+                task = takeTask(_index);
+                m_queued--;
+                m_running++;
+            }
+            m_stateCV.notify_all();
+
+            try
+            {
+                task();
+            }
+            catch (std::exception const& _ex)
+            {
+                // Tests report errors to TestOutputHelper, nothing should get here
+                if (!ExitHandler::receivedExitSignal())
+                    ETH_STDERROR_MESSAGE(string("Unhandled exception in a test thread: ") + _ex.what());
+            }
+
+            {
+                std::lock_guard<std::mutex> lk(m_mutex);
+                m_running--;
+            }
+            m_stateCV.notify_all();
+        }
+
+        // The session of this worker could be reused by the next workers
+        RPCSession::sessionEnd(std::this_thread::get_id(), RPCSession::SessionStatus::Available);
+    }
+
+    // m_mutex must be locked, m_queued > 0
+    std::function<void()> takeTask(size_t _index)
+    {
+        std::deque<std::function<void()>>& own = m_queues.at(_index);
+        if (!own.empty())
+        {
+            std::function<void()> task = std::move(own.front());
+            own.pop_front();
+            return task;
+        }
+        for (size_t i = 1; i < m_queues.size(); i++)
+        {
+            std::deque<std::function<void()>>& other = m_queues.at((_index + i) % m_queues.size());
+            if (!other.empty())
+            {
+                std::function<void()> task = std::move(other.back());
+                other.pop_back();
+                return task;
+            }
+        }
+        assert(false);
+        return std::function<void()>();
+    }
+
+    std::vector<std::thread> m_threads;
+    std::vector<std::deque<std::function<void()>>> m_queues;
+    std::mutex m_mutex;
+    std::condition_variable m_taskCV;   // tasks are queued or the pool stops
+    std::condition_variable m_stateCV;  // a task was taken or finished
+    size_t m_nextQueue = 0;
+    size_t m_queued = 0;
+    size_t m_running = 0;
+    bool m_stop = false;
+};
+}  // namespace
 
 size_t ThreadManager::getMaxAllowedThreads()
 {
@@ -33,23 +264,11 @@ size_t ThreadManager::getMaxAllowedThreads()
     return maxAllowedThreads;
 }
 
-void ThreadManager::addTask(std::function<void()> _job)
+std::mutex g_maxthreadsmutex;
+size_t ThreadManager::maxAllowedThreads()
 {
-    {
-         std::lock_guard<std::mutex> lk(g_jobsmutex);
-         g_activejobs++;
-    }
-
-    auto wrappedJob = [_job](){
-        _job();
-        g_cv.notify_one();
-        std::lock_guard<std::mutex> lk(g_jobsmutex);
-        g_activejobs--;
-    };
-    thread workThread(wrappedJob);
-    threadMap.emplace(workThread.get_id(), std::move(workThread));
-
     // See how many connections we can afford on current running configuration
+    std::lock_guard<std::mutex> lock(g_maxthreadsmutex);
     static size_t maxAllowedThreads = getMaxAllowedThreads();
     ClientConfig const& currConfig = Options::get().getDynamicOptions().getCurrentConfig();
     if (currConfigId != currConfig.getId().id())
@@ -57,68 +276,52 @@ void ThreadManager::addTask(std::function<void()> _job)
         currConfigId = currConfig.getId().id();
         maxAllowedThreads = getMaxAllowedThreads();
     }
+    return maxAllowedThreads;
+}
 
-    // Wait for at least one connection to finish it's task
-    if (threadMap.size() == maxAllowedThreads)
-    {
-        waitForAtLeastOneJobToFinish();
-        joinThreads(false);
-    }
+void ThreadManager::addTask(std::function<void()> _job)
+{
+    WorkerPool& pool = WorkerPool::get();
+    size_t const maxThreads = maxAllowedThreads();
+    // Current client configuration might allow another number of connections
+    pool.start(maxThreads);
+
+    pool.addTask([_job]() {
+        if (!ExitHandler::receivedExitSignal())
+            _job();
+    });
 }
 
-void ThreadManager::joinThreads(bool _all)
+void ThreadManager::runSubTasks(std::vector<std::function<void()>> const& _jobs)
 {
-    if (_all)
-    {
-        for (auto& th : threadMap)
-        {
-            th.second.join();
-            // A thread with exception thrown still being joined here!
-            RPCSession::sessionEnd(th.first, RPCSession::SessionStatus::Available);
-        }
-        threadMap.clear();
-        if (ExitHandler::receivedExitSignal())
-        {
-            // if one of the tests threads failed with fatal exception stop retesteth execution
-            ExitHandler::doExit();
-        }
-        // otherwise continue test execution
-        return;
-    }
+    WorkerPool& pool = WorkerPool::get();
+    if (pool.size() == 0)
+        pool.start(maxAllowedThreads());
 
-    bool finished = false;
-    while (!finished)
-    {
-        for (std::map<thread::id, thread>::iterator it = threadMap.begin(); it != threadMap.end(); it++)
-        {
-            auto status = RPCSession::sessionStatus(it->first);
-            if (status == RPCSession::HasFinished)
-            {
-                thread::id const& id = it->first;
-                it->second.join();
-                RPCSession::sessionEnd(id, RPCSession::SessionStatus::Available);
-                threadMap.erase(it);
-                return;
-            }
-            else if (status == RPCSession::NotExist && ExitHandler::receivedExitSignal())
-                return;
-        }
+    // Let idle workers join the execution, the calling thread works on the group as well
+    auto group = std::make_shared<SubTaskGroup>(_jobs);
+    if (_jobs.size() > 1 && pool.size() > 1)
+        pool.addLocalTasks([group]() { group->work(); }, std::min(_jobs.size(), pool.size()) - 1);
+    group->work();
+    group->wait();
 
-        // The session availability check is time consuming. Let other threads to work
-        if (Options::get().threadCount > 1)
-            std::this_thread::sleep_for(25ms);
-    }
+    for (auto const& error : group->errors())
+        if (error)
+            std::rethrow_exception(error);
 }
 
-void ThreadManager::waitForAtLeastOneJobToFinish()
+void ThreadManager::joinThreads()
 {
-    std::unique_lock<std::mutex> lkj(g_jobsmutex);
-    if (g_activejobs != 0)
+    WorkerPool::get().join();
+    if (ExitHandler::receivedExitSignal())
     {
-        lkj.unlock();
-        std::unique_lock<std::mutex> lk(g_callbackmutex);
-        g_cv.wait(lk);
+        // if one of the tests threads failed with fatal exception stop retesteth execution
+        ExitHandler::doExit();
     }
-    else
-        lkj.unlock();
+    // otherwise continue test execution
+}
+
+void ThreadManager::stopWorkers()
+{
+    WorkerPool::get().stop();
 }
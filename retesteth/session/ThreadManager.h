@@ -1,20 +1,31 @@
 #pragma once
 #include <stdio.h>
-#include <map>
-#include <thread>
 #include <functional>
+#include <vector>
 
 // Manages jobs ensuring that only as many as -j flag allows are currently running
+// Jobs are executed on a pool of persistent worker threads. Each worker keeps its own client session
 // Construct over the Session class which manages new connections to the clients
 class ThreadManager
 {
 public:
-    static void joinThreads(bool _all = true);
+    // Wait for all added jobs to finish
+    static void joinThreads();
     static void addTask(std::function<void()> _job);
+
+    // Run sub jobs of a running test (i.e. forks of a state test) on idle workers
+    // The calling thread executes the jobs that are not taken by other workers
+    // Returns when all jobs are finished. Rethrows the exception of the first failed job
+    static void runSubTasks(std::vector<std::function<void()>> const& _jobs);
+
+    // Finish the queued jobs and stop the worker threads
+    static void stopWorkers();
+
+    // How many jobs can run at once with the current client configuration
+    static size_t maxAllowedThreads();
+
 private:
     ThreadManager() {}
-    static void waitForAtLeastOneJobToFinish();
     static size_t getMaxAllowedThreads();
-    static std::map<std::thread::id, std::thread> threadMap;
     static unsigned int currConfigId;
 };
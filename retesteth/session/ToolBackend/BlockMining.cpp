@@ -1,6 +1,10 @@
 #include "BlockMining.h"
 #include "Options.h"
 #include "ToolChainHelper.h"
+#include "ToolLibrary.h"
+#include "ToolServer.h"
+#include "ToolStateReader.h"
+#include "TransitionCache.h"
 #include "dataObject/ConvertFile.h"
 #include "dataObject/DataObject.h"
 #include <libdevcore/CommonIO.h>
@@ -32,6 +36,26 @@ BlockchainTestFillerEnv* readBlockchainFillerTestEnv(spDataObjectMove _data, Sea
 
 namespace toolimpl
 {
+BlockMining::BlockMining(ToolChain const& _toolChain, EthereumBlockState const& _currentBlock,
+    EthereumBlockState const& _parentBlock, SealEngine _engine)
+  : m_chainRef(_toolChain), m_currentBlockRef(_currentBlock), m_parentBlockRef(_parentBlock), m_engine(_engine)
+{
+    m_toolServerPath = Options::getCurrentConfig().cfgFile().toolServer();
+    m_transport = configTransport();
+}
+
+BlockMining::ToolTransport BlockMining::configTransport()
+{
+    auto const& cfgFile = Options::getCurrentConfig().cfgFile();
+    if (cfgFile.socketType() == ClientConfgSocketType::TransitionLibrary)
+        return ToolTransport::Library;
+    if (!cfgFile.toolServer().empty())
+        return ToolTransport::Server;
+    if (cfgFile.toolStdio())
+        return ToolTransport::Stdio;
+    return ToolTransport::Files;
+}
+
 void BlockMining::prepareEnvFile()
 {
     m_envPath = m_chainRef.tmpDir() / "env.json";
@@ -53,10 +77,9 @@ void BlockMining::prepareEnvFile()
         (*envData)["currentRandom"] = m_currentBlockRef.header()->mixHash().asString();
     }
 
-    // BlockHeader hash information for tool mining
-    size_t k = 0;
-    for (auto const& bl : m_chainRef.blocks())
-        (*envData)["blockHashes"][fto_string(k++)] = bl.header()->hash().asString();
+    // BlockHeader hash information for tool mining (blocks reachable by BLOCKHASH)
+    if (m_chainRef.blockHashes()->getSubObjects().size())
+        (*envData).atKeyPointer("blockHashes") = m_chainRef.blockHashes()->copy();
     for (auto const& un : m_currentBlockRef.uncles())
     {
         spDataObject uncle;
@@ -71,22 +94,37 @@ void BlockMining::prepareEnvFile()
     // Options Hook
     Options::getCurrentConfig().performFieldReplace(envData.getContent(), FieldReplaceDir::RetestethToClient);
 
+    // Stdin input is passed in memory, no files
+    if (m_transport != ToolTransport::Files)
+    {
+        m_envPathContent = envData->asJson(0, false);
+        return;
+    }
+
     m_envPathContent = envData->asJson();
     writeFile(m_envPath.string(), m_envPathContent);
 }
 
 void BlockMining::prepareAllocFile()
 {
+    if (m_transport != ToolTransport::Files)
+    {
+        m_allocPathContent = m_currentBlockRef.state()->asJsonAlloc(false);
+        return;
+    }
+
     m_allocPath = m_chainRef.tmpDir() / "alloc.json";
-    m_allocPathContent = m_currentBlockRef.state()->asDataObject()->asJsonNoFirstKey();
+    m_allocPathContent = m_currentBlockRef.state()->asJsonAlloc();
     writeFile(m_allocPath.string(), m_allocPathContent);
 }
 
 void BlockMining::prepareTxnFile()
 {
-    bool exportRLP = true;
+    bool const exportRLP = m_txsAsRLP;
     string const txsfile = exportRLP ? "txs.rlp" : "txs.json";
-    m_txsPath = m_chainRef.tmpDir() / txsfile;
+    bool const writeFiles = m_transport == ToolTransport::Files;
+    if (writeFiles)
+        m_txsPath = m_chainRef.tmpDir() / txsfile;
 
     string txsPathContent;
     if (exportRLP)
@@ -95,7 +133,8 @@ void BlockMining::prepareTxnFile()
         for (auto const& tr : m_currentBlockRef.transactions())
             txsout.appendRaw(tr->asRLPStream().out());
         m_txsPathContent =  "\"" + dev::toString(txsout.out()) + "\"";
-        writeFile(m_txsPath.string(), m_txsPathContent);
+        if (writeFiles)
+            writeFile(m_txsPath.string(), m_txsPathContent);
     }
     else
     {
@@ -110,42 +149,46 @@ void BlockMining::prepareTxnFile()
                             TestOutputHelper::get().testInfo().errorDebug());
         }
         Options::getCurrentConfig().performFieldReplace(txs, FieldReplaceDir::RetestethToClient);
-        m_txsPathContent = txs.asJson();
-        writeFile(m_txsPath.string(), m_txsPathContent);
+        m_txsPathContent = txs.asJson(0, writeFiles);
+        if (writeFiles)
+            writeFile(m_txsPath.string(), m_txsPathContent);
     }
 }
 
-void BlockMining::executeTransition()
+string BlockMining::prepareTransitionArgs() const
 {
-    m_outPath = m_chainRef.tmpDir() / "out.json";
-    m_outAllocPath = m_chainRef.tmpDir() / "outAlloc.json";
-
-    string cmd = m_chainRef.toolPath().string();
+    string args;
 
     // Convert FrontierToHomesteadAt5 -> Homestead if block > 5, and get reward
     auto tupleRewardFork = prepareReward(m_engine, m_chainRef.fork(), m_currentBlockRef.header()->number(), m_currentBlockRef.totalDifficulty());
-    cmd += " --state.fork " + std::get<1>(tupleRewardFork).asString();
+    args += " --state.fork " + std::get<1>(tupleRewardFork).asString();
     if (m_engine != SealEngine::NoReward)
-        cmd += " --state.reward " + std::get<0>(tupleRewardFork).asDecString();
-
-    cmd += " --input.alloc " + m_allocPath.string();
-    cmd += " --input.txs " + m_txsPath.string();
-    cmd += " --input.env " + m_envPath.string();
-    cmd += " --output.basedir " + m_chainRef.tmpDir().string();
-    cmd += " --output.result " + m_outPath.filename().string();
-    cmd += " --output.alloc " + m_outAllocPath.filename().string();
+        args += " --state.reward " + std::get<0>(tupleRewardFork).asDecString();
 
     bool traceCondition = Options::get().vmtrace && m_currentBlockRef.header()->number() != 0;
     if (traceCondition)
     {
-        cmd += " --trace ";
+        args += " --trace ";
         if (!Options::get().vmtrace_nomemory)
-            cmd += "--trace.memory ";
+            args += "--trace.memory ";
         if (!Options::get().vmtrace_noreturndata)
-            cmd += "--trace.returndata ";
+            args += "--trace.returndata ";
         if (Options::get().vmtrace_nostack)
-            cmd += "--trace.nostack ";
+            args += "--trace.nostack ";
     }
+    return args;
+}
+
+string BlockMining::prepareTransitionInput() const
+{
+    // {"alloc" : {..}, "env" : {..}, "txsRlp" : "0x.."} as t8n reads it from stdin
+    return "{\"alloc\":" + m_allocPathContent + ",\"env\":" + m_envPathContent +
+           (m_txsAsRLP ? ",\"txsRlp\":" : ",\"txs\":") + m_txsPathContent + "}";
+}
+
+void BlockMining::executeTransition()
+{
+    string const args = prepareTransitionArgs();
 
     ETH_TEST_MESSAGE("Alloc:\n" + m_allocPathContent);
     if (m_currentBlockRef.transactions().size())
@@ -156,6 +199,63 @@ void BlockMining::executeTransition()
     }
     ETH_TEST_MESSAGE("Env:\n" + m_envPathContent);
 
+    // Trace files are produced by the tool run, so traced blocks are never replayed
+    bool const traceCondition = Options::get().vmtrace && m_currentBlockRef.header()->number() != 0;
+    if (TransitionCache::enabled() && !traceCondition)
+    {
+        m_cacheKey = TransitionCache::makeKey(m_chainRef.toolPath(), args, prepareTransitionInput());
+        if (TransitionCache::find(m_cacheKey, m_toolStdoutResponse))
+        {
+            m_cacheHit = true;
+            ETH_TEST_MESSAGE("TransitionCache hit: " + m_cacheKey);
+            return;
+        }
+    }
+
+    if (m_transport == ToolTransport::Server)
+    {
+        string const serverArgs = args + " --output.basedir " + m_chainRef.tmpDir().string();
+        ToolServer& server = ToolServer::get(m_toolServerPath, m_chainRef.tmpDir());
+        m_toolStdoutResponse = server.request(serverArgs, prepareTransitionInput());
+        ETH_TEST_MESSAGE(m_toolServerPath.string() + serverArgs);
+        return;
+    }
+
+    if (m_transport == ToolTransport::Library)
+    {
+        string const libArgs = args + " --output.basedir " + m_chainRef.tmpDir().string();
+        ToolLibrary const& library = ToolLibrary::get(m_chainRef.toolPath());
+        m_toolStdoutResponse =
+            library.apply(libArgs, m_allocPathContent, m_envPathContent, m_txsPathContent, m_txsAsRLP);
+        ETH_TEST_MESSAGE(m_chainRef.toolPath().string() + libArgs);
+        return;
+    }
+
+    if (m_transport == ToolTransport::Stdio)
+    {
+        // Basedir is only used by the tool for trace files
+        string cmd = m_chainRef.toolPath().string();
+        cmd += args;
+        cmd += " --input.alloc stdin --input.txs stdin --input.env stdin";
+        cmd += " --output.basedir " + m_chainRef.tmpDir().string();
+        cmd += " --output.result stdout --output.alloc stdout";
+        m_toolStdoutResponse = test::executeCmdWithInput(cmd, prepareTransitionInput(), ExecCMDWarning::NoWarning);
+        ETH_TEST_MESSAGE(cmd);
+        return;
+    }
+
+    m_outPath = m_chainRef.tmpDir() / "out.json";
+    m_outAllocPath = m_chainRef.tmpDir() / "outAlloc.json";
+
+    string cmd = m_chainRef.toolPath().string();
+    cmd += args;
+    cmd += " --input.alloc " + m_allocPath.string();
+    cmd += " --input.txs " + m_txsPath.string();
+    cmd += " --input.env " + m_envPath.string();
+    cmd += " --output.basedir " + m_chainRef.tmpDir().string();
+    cmd += " --output.result " + m_outPath.filename().string();
+    cmd += " --output.alloc " + m_outAllocPath.filename().string();
+
     string out = test::executeCmd(cmd, ExecCMDWarning::NoWarning);
     ETH_TEST_MESSAGE(cmd);
     ETH_TEST_MESSAGE(out);
@@ -163,6 +263,30 @@ void BlockMining::executeTransition()
 
 ToolResponse BlockMining::readResult()
 {
+    if (m_transport != ToolTransport::Files || m_cacheHit)
+    {
+        ETH_TEST_MESSAGE("Res:\n" + m_toolStdoutResponse);
+        if (m_toolStdoutResponse.empty())
+            ETH_ERROR_MESSAGE("Tool returned empty response: " + m_chainRef.toolPath().string());
+        size_t resultBegin = 0, resultEnd = 0, allocBegin = 0, allocEnd = 0;
+        if (!findJsonTopLevelValue(m_toolStdoutResponse, "result", resultBegin, resultEnd) ||
+            !findJsonTopLevelValue(m_toolStdoutResponse, "alloc", allocBegin, allocEnd))
+            ETH_ERROR_MESSAGE("Tool response missing `result` or `alloc`: " + m_toolStdoutResponse);
+
+        // Only the result is built as DataObject, alloc is read straight into the State
+        ToolResponse toolResponse(
+            ConvertJsoncppStringToData(m_toolStdoutResponse.substr(resultBegin, resultEnd - resultBegin)));
+        toolResponse.attachState(
+            readToolAlloc(m_toolStdoutResponse, allocBegin, allocEnd, &m_currentBlockRef.state().getCContent()));
+        if (!m_cacheKey.empty() && !m_cacheHit)
+            TransitionCache::insert(m_cacheKey, m_toolStdoutResponse);
+
+        bool traceCondition = Options::get().vmtrace && m_currentBlockRef.header()->number() != 0;
+        if (traceCondition)
+            traceTransactions(toolResponse);
+        return toolResponse;
+    }
+
     string const outPathContent = dev::contentsString(m_outPath.string());
     string const outAllocPathContent = dev::contentsString(m_outAllocPath.string());
     ETH_TEST_MESSAGE("Res:\n" + outPathContent);
@@ -174,8 +298,9 @@ ToolResponse BlockMining::readResult()
 
     // Construct block rpc response
     ToolResponse toolResponse(ConvertJsoncppStringToData(outPathContent));
-    spDataObject returnState = ConvertJsoncppStringToData(outAllocPathContent);
-    toolResponse.attachState(restoreFullState(returnState.getContent()));
+    toolResponse.attachState(readToolAlloc(outAllocPathContent, &m_currentBlockRef.state().getCContent()));
+    if (!m_cacheKey.empty())
+        TransitionCache::insert(m_cacheKey, "{\"result\":" + outPathContent + ",\"alloc\":" + outAllocPathContent + "}");
 
     bool traceCondition = Options::get().vmtrace && m_currentBlockRef.header()->number() != 0;
     if (traceCondition)
@@ -198,7 +323,7 @@ void BlockMining::traceTransactions(ToolResponse& _toolResponse)
             string const info = TestOutputHelper::get().testInfo().errorDebug();
             string const traceinfo = "\nVMTrace:" + info + cDefault + preinfo;
             _toolResponse.attachDebugTrace(
-                tr->hash(), DebugVMTrace(traceinfo, trNumber, tr->hash(), dev::contentsString(txTraceFile)));
+                tr->hash(), DebugVMTrace(traceinfo, trNumber, tr->hash(), txTraceFile));
         }
         else
             ETH_LOG("Trace file `" + txTraceFile.string() + "` not found!", 1);
@@ -207,6 +332,8 @@ void BlockMining::traceTransactions(ToolResponse& _toolResponse)
 
 BlockMining::~BlockMining()
 {
+    if (m_transport != ToolTransport::Files)
+        return;
     fs::remove(m_envPath);
     fs::remove(m_allocPath);
     fs::remove(m_txsPath);
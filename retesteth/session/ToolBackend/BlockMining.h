@@ -12,9 +12,7 @@ class BlockMining
 {
 public:
     BlockMining(ToolChain const& _toolChain, EthereumBlockState const& _currentBlock, EthereumBlockState const& _parentBlock,
-        SealEngine _engine)
-      : m_chainRef(_toolChain), m_currentBlockRef(_currentBlock), m_parentBlockRef(_parentBlock), m_engine(_engine)
-    {}
+        SealEngine _engine);
     ~BlockMining();
 
     void prepareEnvFile();
@@ -29,6 +27,23 @@ private:
     EthereumBlockState const& m_parentBlockRef;
     SealEngine m_engine;
 
+    // How the block data is passed to the tool (set in client config)
+    enum class ToolTransport
+    {
+        Files,   // tool process per block, input/output via files in tmpDir
+        Stdio,   // tool process per block, input via stdin, output via stdout
+        Server,  // persistent tool server process
+        Library  // transition library inside retesteth process
+    };
+    static ToolTransport configTransport();
+    ToolTransport m_transport = ToolTransport::Files;
+    fs::path m_toolServerPath;
+    string m_toolStdoutResponse;
+
+    // Cached tool results (if enabled in options)
+    string m_cacheKey;
+    bool m_cacheHit = false;
+
 private:
     fs::path m_allocPath;
     string m_allocPathContent;
@@ -36,8 +51,11 @@ private:
     string m_envPathContent;
     fs::path m_txsPath;
     string m_txsPathContent;
+    bool m_txsAsRLP = true;
     fs::path m_outPath;
     fs::path m_outAllocPath;
+    string prepareTransitionArgs() const;
+    string prepareTransitionInput() const;
     void traceTransactions(ToolResponse& _toolResponse);
 };
 }  // namespace toolimpl
@@ -0,0 +1,133 @@
+#include "GenesisCache.h"
+#include <Options.h>
+#include <libdevcore/CommonIO.h>
+#include <libdevcore/SHA3.h>
+#include <deque>
+#include <fstream>
+#include <map>
+#include <mutex>
+
+using namespace std;
+using namespace test;
+using namespace dev;
+
+namespace
+{
+size_t const c_maxGenesisRecords = 20000;
+
+std::mutex g_genesisCacheMutex;
+std::map<string, string> g_genesisCache;
+std::deque<string> g_genesisOrder;  // keys in the file order, oldest first
+size_t g_genesisFileRecords = 0;    // lines in the file, including duplicates of parallel runs
+bool g_genesisCacheLoaded = false;
+
+fs::path genesisCacheFile()
+{
+    auto const& cacheDir = Options::get().toolCacheDir;
+    if (!cacheDir.is_initialized())
+        return fs::path();
+    return cacheDir.get() / "genesisroots.txt";
+}
+
+// Keep the newest half of the records and rewrite the file with them. Called under the mutex
+void compactGenesisCache(fs::path const& _file)
+{
+    while (g_genesisOrder.size() > c_maxGenesisRecords / 2)
+    {
+        g_genesisCache.erase(g_genesisOrder.front());
+        g_genesisOrder.pop_front();
+    }
+
+    // Write to a temporary file first, so a parallel reader never sees a partial file
+    fs::path const tmpFile = _file.parent_path() / fs::unique_path("genesisroots.%%%%%%.tmp");
+    {
+        std::ofstream out(tmpFile.string());
+        for (auto const& key : g_genesisOrder)
+            out << key << " " << g_genesisCache.at(key) << "\n";
+    }
+    boost::system::error_code ec;
+    fs::rename(tmpFile, _file, ec);
+    if (ec)
+        fs::remove(tmpFile, ec);
+    g_genesisFileRecords = g_genesisOrder.size();
+    ETH_LOG("GenesisCache compacted " + _file.string() + " to " + fto_string(g_genesisFileRecords) + " roots", 6);
+}
+
+// Read `key stateRoot` lines of the persisted cache. Called under the mutex
+void loadGenesisCache()
+{
+    g_genesisCacheLoaded = true;
+    fs::path const file = genesisCacheFile();
+    if (file.empty() || !fs::exists(file))
+        return;
+
+    std::ifstream in(file.string());
+    string key;
+    string root;
+    while (in >> key >> root)
+    {
+        g_genesisFileRecords++;
+        if (g_genesisCache.emplace(key, root).second)
+            g_genesisOrder.push_back(key);
+    }
+    ETH_LOG("GenesisCache loaded " + fto_string(g_genesisCache.size()) + " roots from " + file.string(), 6);
+    if (g_genesisFileRecords > c_maxGenesisRecords)
+        compactGenesisCache(file);
+}
+}  // namespace
+
+namespace toolimpl
+{
+string GenesisCache::makeKey(
+    EthereumBlockState const& _genesis, FORK const& _fork, fs::path const& _toolPath, string const& _toolVersion)
+{
+    string const content = _toolPath.string() + "\n" + _toolVersion + "\n" + _fork.asString() + "\n" +
+                           _genesis.header()->asDataObject()->asJson(0, false) + "\n" +
+                           _genesis.state()->asJsonAlloc(false);
+    return dev::toString(dev::sha3(content));
+}
+
+bool GenesisCache::find(string const& _key, string& _stateRoot)
+{
+    std::lock_guard<std::mutex> lock(g_genesisCacheMutex);
+    if (!g_genesisCacheLoaded)
+        loadGenesisCache();
+    auto const it = g_genesisCache.find(_key);
+    if (it == g_genesisCache.end())
+        return false;
+    _stateRoot = it->second;
+    return true;
+}
+
+void GenesisCache::insert(string const& _key, string const& _stateRoot)
+{
+    std::lock_guard<std::mutex> lock(g_genesisCacheMutex);
+    if (!g_genesisCacheLoaded)
+        loadGenesisCache();
+    if (!g_genesisCache.emplace(_key, _stateRoot).second)
+        return;
+    g_genesisOrder.push_back(_key);
+
+    fs::path const file = genesisCacheFile();
+    if (file.empty())
+    {
+        // Memory only cache is bounded the same way
+        if (g_genesisOrder.size() > c_maxGenesisRecords)
+        {
+            g_genesisCache.erase(g_genesisOrder.front());
+            g_genesisOrder.pop_front();
+        }
+        return;
+    }
+
+    if (++g_genesisFileRecords > c_maxGenesisRecords)
+        compactGenesisCache(file);
+    else
+    {
+        // One short line per append, so parallel runs sharing the dir do not mix the records
+        std::ofstream out(file.string(), std::ios::app);
+        out << _key << " " << _stateRoot << "\n";
+    }
+}
+
+}  // namespace toolimpl
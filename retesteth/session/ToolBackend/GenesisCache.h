@@ -0,0 +1,25 @@
+#pragma once
+#include <testStructures/types/ethereum.h>
+#include <boost/filesystem.hpp>
+#include <string>
+namespace fs = boost::filesystem;
+
+namespace toolimpl
+{
+// Process wide cache of genesis state roots calculated by the tool
+// Same pre-state is constructed for every fork of a filler, ask the tool only once
+// The key is a hash of (tool path, tool version, fork, genesis header, genesis state)
+// With `--toolcache <dir>` the cache is persisted to <dir>/genesisroots.txt between runs
+// The file keeps the most recent records only, older ones are dropped when it grows over the limit
+class GenesisCache
+{
+public:
+    static std::string makeKey(EthereumBlockState const& _genesis, FORK const& _fork, fs::path const& _toolPath,
+        std::string const& _toolVersion);
+
+    // Return true and set _stateRoot if the key is known
+    static bool find(std::string const& _key, std::string& _stateRoot);
+    static void insert(std::string const& _key, std::string const& _stateRoot);
+};
+
+}  // namespace toolimpl
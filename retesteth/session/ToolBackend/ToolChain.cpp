@@ -1,4 +1,6 @@
 #include "BlockMining.h"
+#include "GenesisCache.h"
+#include "TransitionCache.h"
 #include "ToolChainHelper.h"
 #include "ToolChainManager.h"
 #include <Options.h>
@@ -15,6 +17,9 @@ using namespace teststruct;
 using namespace dataobject;
 
 namespace  {
+// BLOCKHASH opcode can only reach this many previous blocks
+size_t const c_blockHashesWindow = 256;
+
 void correctHeaderByToolResponse(BlockHeader& _header, ToolResponse const& _res)
 {
     // Update a block header with information that we have and what we get from t8ntool
@@ -56,13 +61,22 @@ ToolChain::ToolChain(
     }
 
     // We yet don't know the state root of genesis. Ask the tool to calculate it
-    ToolResponse const res = mineBlockOnTool(_genesis, _genesis, SealEngine::NoReward);
+    // Same genesis is often constructed for every fork of a test, so cache the answer
+    string stateRoot;
+    string const cacheKey =
+        GenesisCache::makeKey(_genesis, m_fork, m_toolPath, TransitionCache::toolVersion(m_toolPath));
+    if (!GenesisCache::find(cacheKey, stateRoot))
+    {
+        ToolResponse const res = mineBlockOnTool(_genesis, _genesis, SealEngine::NoReward);
+        stateRoot = res.stateRoot().asString();
+        GenesisCache::insert(cacheKey, stateRoot);
+    }
 
     EthereumBlockState genesisFixed(_genesis.header(), _genesis.state(), FH32::zero());
-    genesisFixed.headerUnsafe().getContent().setStateRoot(res.stateRoot());
+    genesisFixed.headerUnsafe().getContent().setStateRoot(FH32(stateRoot));
     genesisFixed.headerUnsafe().getContent().recalculateHash();
     genesisFixed.setTotalDifficulty(genesisFixed.header()->difficulty());
-    m_blocks.push_back(genesisFixed);
+    pushBlock(genesisFixed);
 }
 
 ToolChain::ToolChain(
@@ -76,7 +90,7 @@ ToolChain::ToolChain(
 {
     // Calculate the difficutly of _currentBlock given _parentBlock
     ToolResponse res = mineBlockOnTool(_currentBlock, _parentBlock, SealEngine::NoReward);
-    m_blocks.push_back(_currentBlock);
+    pushBlock(_currentBlock);
     m_blocks.back().headerUnsafe().getContent().setDifficulty(res.currentDifficulty());
 }
 
@@ -116,7 +130,7 @@ spDataObject const ToolChain::mineBlock(EthereumBlockState const& _pendingBlock,
     calculateAndSetTotalDifficulty(pendingFixed);
 
     pendingFixed.setTrsTrace(res.debugTrace());
-    m_blocks.push_back(pendingFixed);
+    pushBlock(pendingFixed);
     return miningResult;
 }
 
@@ -124,9 +138,11 @@ ToolResponse ToolChain::mineBlockOnTool(
     EthereumBlockState const& _currentBlock, EthereumBlockState const& _parentBlock, SealEngine _engine)
 {
     BlockMining toolMiner(*this, _currentBlock, _parentBlock, _engine);
+
+    // Alloc json is cached in the state, a block built on the same parent does not serialize it again
     toolMiner.prepareEnvFile();
-    toolMiner.prepareAllocFile();
     toolMiner.prepareTxnFile();
+    toolMiner.prepareAllocFile();
     toolMiner.executeTransition();
     return toolMiner.readResult();
 }
@@ -135,6 +151,20 @@ void ToolChain::rewindToBlock(size_t _number)
 {
     while (m_blocks.size() > _number + 1)
         m_blocks.pop_back();
+
+    m_blockHashes = spDataObject(new DataObject(DataType::Object));
+    size_t const first = m_blocks.size() > c_blockHashesWindow ? m_blocks.size() - c_blockHashesWindow : 0;
+    for (size_t k = first; k < m_blocks.size(); k++)
+        (*m_blockHashes)[fto_string(k)] = m_blocks.at(k).header()->hash().asString();
+}
+
+void ToolChain::pushBlock(EthereumBlockState const& _block)
+{
+    m_blocks.push_back(_block);
+    size_t const k = m_blocks.size() - 1;
+    (*m_blockHashes)[fto_string(k)] = _block.header()->hash().asString();
+    if (k >= c_blockHashesWindow)
+        (*m_blockHashes).removeKey(fto_string(k - c_blockHashesWindow));
 }
 
 // Helper functions
@@ -246,12 +276,10 @@ void ToolChain::additionalHeaderVerification(
             _pendingFixed.header()->extraData().asString() != "0x64616f2d686172642d666f726b")
             throw test::UpwardsException("Dao Extra Data required!");
 
-        spDataObject const pendingH = _pendingBlock.header()->asDataObject();
-        spDataObject const pendingFixedH = _pendingFixed.header()->asDataObject();
-        if (pendingH->asJson(0, false) != pendingFixedH->asJson(0, false))
+        if (!_pendingBlock.header()->equals(_pendingFixed.header().getCContent()))
         {
             string errField;
-            string const compare = compareBlockHeaders(pendingH, pendingFixedH, errField);
+            string const compare = _pendingBlock.header()->diff(_pendingFixed.header().getCContent(), errField);
             throw test::UpwardsException(string("Block from pending block != t8ntool constructed block!\n") +
                                          "Error in field: " + errField + "\n" +
                                          "rawRLP/Pending header  vs  t8ntool header \n" + compare);
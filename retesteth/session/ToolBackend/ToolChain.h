@@ -45,6 +45,9 @@ public:
     }
 
     std::vector<EthereumBlockState> const& blocks() const { return m_blocks; }
+
+    // t8ntool env.blockHashes of the next block. Only last 256 blocks are reachable by BLOCKHASH
+    spDataObject const& blockHashes() const { return m_blockHashes; }
     SealEngine engine() const { return m_engine; }
     FORK const& fork() const { return m_fork; }
     fs::path const& toolPath() const { return m_toolPath; }
@@ -60,7 +63,7 @@ public:
     void rewindToBlock(size_t _number);
 
     // Used for chain reorg
-    void insertBlock(EthereumBlockState const& _block) { m_blocks.push_back(_block); }
+    void insertBlock(EthereumBlockState const& _block) { pushBlock(_block); }
     fs::path const& tmpDir() const { return m_tmpDir; }
 
 private:
@@ -73,12 +76,14 @@ private:
     GCP_SPointer<ToolParams> m_toolParams;
     const spSetChainParamsArgs m_initialParams;
     std::vector<EthereumBlockState> m_blocks;
+    spDataObject m_blockHashes;
     SealEngine m_engine;
     spFORK m_fork;
     fs::path m_toolPath;
     fs::path m_tmpDir;
 
 private:
+    void pushBlock(EthereumBlockState const& _block);
     void checkDifficultyAgainstRetesteth(VALUE const& _toolDifficulty, spBlockHeader const& _pendingHeader);
     void calculateAndSetBaseFee(spBlockHeader& _pendingHeader, spBlockHeader const& _parentHeader);
     spDataObject coorectTransactionsByToolResponse(ToolResponse const& _res, EthereumBlockState& _pendingFixed,
@@ -137,32 +137,6 @@ VALUE calculateGasLimit(VALUE const& _parentGasLimit, VALUE const& _parentGasUse
             gasFloorTarget, gasLimit - gasLimit / boundDivisor + 1 + (_parentGasUsed.asBigInt() * 6 / 5) / boundDivisor);
 }
 
-// Because tool report incomplete state. restore missing fields with zeros
-// Also remove leading zeros in storage
-State restoreFullState(DataObject& _toolState)
-{
-    spDataObject fullState;
-    for (auto& accTool2 : _toolState.getSubObjectsUnsafe())
-    {
-        DataObject& accTool = accTool2.getContent();
-        DataObject& acc = fullState.getContent()[accTool.getKey()];
-        acc["balance"] = accTool.count("balance") ? accTool.atKey("balance").asString() : "0x00";
-        acc["nonce"] = accTool.count("nonce") ? accTool.atKey("nonce").asString() : "0x00";
-        acc["code"] = accTool.count("code") ? accTool.atKey("code").asString() : "0x";
-        if (accTool.count("storage"))
-            acc.atKeyPointer("storage") = accTool.atKeyPointerUnsafe("storage");
-        else
-            acc.atKeyPointer("storage") = spDataObject(new DataObject(DataType::Object));
-        for (auto& storageRecord : acc.atKeyUnsafe("storage").getSubObjectsUnsafe())
-        {
-            storageRecord.getContent().performModifier(mod_removeLeadingZerosFromHexValueEVEN);
-            storageRecord.getContent().performModifier(mod_removeLeadingZerosFromHexKeyEVEN);
-        }
-        //fullState[accTool.getKey()] = acc;
-    }
-    return State(dataobject::move(fullState));
-}
-
 ChainOperationParams ChainOperationParams::defaultParams(ToolParams const& _params)
 {
     ChainOperationParams aleth;
@@ -174,9 +148,39 @@ ChainOperationParams ChainOperationParams::defaultParams(ToolParams const& _para
     aleth.constantinopleForkBlock = _params.constantinopleForkBlock().asBigInt();
     aleth.muirGlacierForkBlock = _params.muirGlacierForkBlock().asBigInt();
     aleth.londonForkBlock = _params.londonForkBlock().asBigInt();
+    aleth.arrowGlacierForkBlock = bigint(10000000000);
+    aleth.grayGlacierForkBlock = bigint(10000000000);
     return aleth;
 }
 
+bool ChainOperationParams::forkParams(FORK const& _fork, ChainOperationParams& _params)
+{
+    // Forks ordered by the difficulty formula changes
+    static std::vector<std::vector<string>> const forkOrder = {{"Frontier"}, {"Homestead", "EIP150", "EIP158"},
+        {"Byzantium"}, {"Constantinople", "ConstantinopleFix", "Istanbul"}, {"Berlin"}, {"London"}, {"ArrowGlacier"},
+        {"GrayGlacier"}};
+
+    size_t level = forkOrder.size();
+    for (size_t i = 0; i < forkOrder.size(); i++)
+        if (test::inArray(forkOrder.at(i), _fork.asString()))
+            level = i;
+    if (level == forkOrder.size())
+        return false;
+
+    bigint const unreachable = 10000000000;
+    _params.durationLimit = u256("0x0d");
+    _params.minimumDifficulty = u256("0x20000");
+    _params.difficultyBoundDivisor = u256("0x0800");
+    _params.homesteadForkBlock = level >= 1 ? 0 : unreachable;
+    _params.byzantiumForkBlock = level >= 2 ? 0 : unreachable;
+    _params.constantinopleForkBlock = level >= 3 ? 0 : unreachable;
+    _params.muirGlacierForkBlock = level >= 4 ? 0 : unreachable;
+    _params.londonForkBlock = level >= 5 ? 0 : unreachable;
+    _params.arrowGlacierForkBlock = level >= 6 ? 0 : unreachable;
+    _params.grayGlacierForkBlock = level >= 7 ? 0 : unreachable;
+    return true;
+}
+
 // Aleth calculate difficulty formula
 VALUE calculateEthashDifficulty(
     ChainOperationParams const& _chainParams, BlockHeader const& _bi, BlockHeader const& _parent)
@@ -213,30 +217,25 @@ VALUE calculateEthashDifficulty(
     VALUE o = target;
     unsigned exponentialIceAgeBlockNumber = (unsigned)_parent.number().asBigInt() + 1;
 
-    // EIP-2384 Istanbul/Berlin Difficulty Bomb Delay
-    if (_bi.number().asBigInt() >= _chainParams.muirGlacierForkBlock)
-    {
-        if (exponentialIceAgeBlockNumber >= 9000000)
-            exponentialIceAgeBlockNumber -= 9000000;
-        else
-            exponentialIceAgeBlockNumber = 0;
-    }
-    // EIP-1234 Constantinople Ice Age delay
-    else if (_bi.number().asBigInt() >= _chainParams.constantinopleForkBlock)
-    {
-        if (exponentialIceAgeBlockNumber >= 5000000)
-            exponentialIceAgeBlockNumber -= 5000000;
-        else
-            exponentialIceAgeBlockNumber = 0;
-    }
-    // EIP-649 Byzantium Ice Age delay
-    else if (_bi.number().asBigInt() >= _chainParams.byzantiumForkBlock)
-    {
-        if (exponentialIceAgeBlockNumber >= 3000000)
-            exponentialIceAgeBlockNumber -= 3000000;
-        else
-            exponentialIceAgeBlockNumber = 0;
-    }
+    unsigned bombDelay = 0;
+    bigint const& number = _bi.number().asBigInt();
+    if (number >= _chainParams.grayGlacierForkBlock)
+        bombDelay = 11400000;  // EIP-5133 Gray Glacier Difficulty Bomb Delay
+    else if (number >= _chainParams.arrowGlacierForkBlock)
+        bombDelay = 10700000;  // EIP-4345 Arrow Glacier Difficulty Bomb Delay
+    else if (number >= _chainParams.londonForkBlock)
+        bombDelay = 9700000;   // EIP-3554 London Difficulty Bomb Delay
+    else if (number >= _chainParams.muirGlacierForkBlock)
+        bombDelay = 9000000;   // EIP-2384 Istanbul/Berlin Difficulty Bomb Delay
+    else if (number >= _chainParams.constantinopleForkBlock)
+        bombDelay = 5000000;   // EIP-1234 Constantinople Ice Age delay
+    else if (number >= _chainParams.byzantiumForkBlock)
+        bombDelay = 3000000;   // EIP-649 Byzantium Ice Age delay
+
+    if (exponentialIceAgeBlockNumber >= bombDelay)
+        exponentialIceAgeBlockNumber -= bombDelay;
+    else
+        exponentialIceAgeBlockNumber = 0;
 
     unsigned periodCount = exponentialIceAgeBlockNumber / c_expDiffPeriod;
     // latter will eventually become huge, so ensure it's a bigint.
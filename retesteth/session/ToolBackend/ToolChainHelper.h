@@ -12,6 +12,10 @@ namespace toolimpl
 struct ChainOperationParams
 {
     static ChainOperationParams defaultParams(ToolParams const& _params);
+
+    // Params of the chain running _fork rules from genesis (t8n fork name)
+    // Return false if ethash difficulty formula of the fork is not known
+    static bool forkParams(FORK const& _fork, ChainOperationParams& _params);
     bigint minimumDifficulty;
     bigint difficultyBoundDivisor;
     bigint durationLimit;
@@ -20,12 +24,13 @@ struct ChainOperationParams
     bigint muirGlacierForkBlock;
     bigint constantinopleForkBlock;
     bigint londonForkBlock;
+    bigint arrowGlacierForkBlock;
+    bigint grayGlacierForkBlock;
 };
 std::tuple<VALUE, FORK> prepareReward(SealEngine _engine, FORK const& _fork, VALUE const& _blockNumber, VALUE const& _currentTD);
 VALUE calculateGasLimit(VALUE const& _parentGasLimit, VALUE const& _parentGasUsed);
 VALUE calculateEthashDifficulty(
     ChainOperationParams const& _chainParams, BlockHeader const& _bi, BlockHeader const& _parent);
 VALUE calculateEIP1559BaseFee(ChainOperationParams const& _chainParams, spBlockHeader const& _bi, spBlockHeader const& _parent);
-State restoreFullState(DataObject& _toolState);
 
 }  // namespace toolimpl
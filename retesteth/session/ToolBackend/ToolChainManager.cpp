@@ -2,12 +2,148 @@
 #include "ToolChainHelper.h"
 #include "ToolImplHelper.h"
 #include <retesteth/EthChecks.h>
+#include <retesteth/Options.h>
 #include <retesteth/TestHelper.h>
 #include <retesteth/testStructures/Common.h>
 #include <retesteth/dataObject/ConvertFile.h>
 #include <retesteth/FileSystem.h>
+#include <retesteth/testStructures/types/Ethereum/BlockHeaderReader.h>
+#include <libdevcore/RLP.h>
+#include <map>
 using namespace test;
 
+namespace
+{
+// Number of vectors of a difficulty batch verified on the tool
+size_t const c_difficultyToolSamples = 8;
+
+// Add transaction to the t9n input list
+void appendT9nTransaction(test::RLPStreamU& _txsout, BYTES const& _rlp)
+{
+    if (_rlp.firstByte() < 128)
+    {
+        // wrap typed transactions as RLPstring in RLPStream
+        _txsout.appendString(_rlp.asString());
+    }
+    else
+        _txsout.appendRaw(_rlp.asString());
+}
+
+// Run t9n on rlp list of transactions, return tool output
+string executeT9n(string const& _txs, FORK const& _fork, fs::path const& _toolPath, fs::path const& _tmpDir)
+{
+    // Prepare transaction file
+    fs::path txsPath = _tmpDir / "tx.rlp";
+    writeFile(txsPath.string(), string("\"") + _txs + "\"");
+    ETH_TEST_MESSAGE("TXS file:\n" + string("\"") + _txs + "\"");
+
+    string cmd = _toolPath.string();
+    cmd += " --input.txs " + txsPath.string();
+    cmd += " --state.fork " + _fork.asString();
+    cmd += " 2>&1";
+    ETH_WARNING_TEST(cmd, 6);
+    string response = test::executeCmd(cmd, ExecCMDWarning::NoWarningNoError);
+
+    ETH_TEST_MESSAGE("T9N Response:\n" + response);
+    return response;
+}
+
+// Read t9n response into the array of transaction results
+spDataObject readT9nResponse(string const& _response, bool& _errorCaught)
+{
+    spDataObject res;
+    try
+    {
+        res = dataobject::ConvertJsoncppStringToData(_response);
+    }
+    catch (std::exception const& _ex) {
+        if (string(_ex.what()).find("can't read json") != string::npos)
+        {
+            // Unable to read json. treat response as exceptional failure on wrong input
+            ETH_WARNING("t9n returned invalid json, probably failed on input!");
+            res = spDataObject(new DataObject(DataType::Array));
+            spDataObject errObj;
+            (*errObj)["error"] = _response;
+            (*res).addSubObject(errObj);
+            ETH_TEST_MESSAGE("T9N Response reconstructed:\n" + res->asJson());
+            _errorCaught = true;
+        }
+        else
+            throw;
+    }
+    return res;
+}
+
+// Convert t9n result of a transaction into test_rawTransaction response
+// Malformed rlp could shift item boundaries in a list of transactions, then the tool results would be
+// attributed to the wrong transactions. Only rlps that are exactly one well formed item go to a batch
+bool isBatchSafeRlp(BYTES const& _rlp)
+{
+    bytes const data = fromHex(_rlp.asString());
+    if (data.empty())
+        return false;
+
+    // Typed transaction is wrapped into an rlp string of its size
+    if (data.at(0) < 128)
+        return true;
+    try
+    {
+        dev::RLP const rlp(data, dev::RLP::VeryStrict);
+        return rlp.actualSize() == data.size();
+    }
+    catch (std::exception const&)
+    {
+        return false;
+    }
+}
+
+string rawTransactionHash(BYTES const& _rlp)
+{
+    return "0x" + dev::toString(dev::sha3(fromHex(_rlp.asString())));
+}
+
+TestRawTransaction makeRawTransactionResult(spDataObject const& _resTr, BYTES const& _rlp, bool _rejected)
+{
+    // Prepare test_mineBlocks response structure
+    DataObject out;
+    out["result"] = true;
+
+    string const hash = rawTransactionHash(_rlp);
+    spDataObject tr;
+
+    if (_resTr->count("intrinsicGas"))
+    {
+        if (_resTr->atKey("intrinsicGas").type() == DataType::Integer)
+            (*tr)["intrinsicGas"] = VALUE(_resTr->atKey("intrinsicGas").asInt()).asString();
+        else if (_resTr->atKey("intrinsicGas").type() == DataType::String)
+            (*tr)["intrinsicGas"] = VALUE(_resTr->atKey("intrinsicGas").asString()).asString();
+        else
+            ETH_ERROR_MESSAGE("`intrinsicGas` field type expected to be Int or String: `" + _resTr->asJson());
+    }
+    else
+        (*tr)["intrinsicGas"] = "0x00";
+
+    if (_rejected)
+    {
+        (*tr)["error"] = _resTr->atKey("error").asString();
+        (*tr)["sender"] = FH20::zero().asString();
+        (*tr)["hash"] = hash;
+        out["rejectedTransactions"].addArrayObject(tr);
+    }
+    else
+    {
+        (*tr)["sender"] = _resTr->atKey("address").asString();
+        (*tr)["hash"] = _resTr->atKey("hash").asString();
+        out["acceptedTransactions"].addArrayObject(tr);
+        if (tr->atKey("hash").asString() != hash)
+            ETH_ERROR_MESSAGE("t8n tool returned different tx.hash than retesteth: (t8n.hash != retesteth.hash) " + tr->atKey("hash").asString() + " != " + hash);
+    }
+
+    ETH_TEST_MESSAGE("Response: test_rawTransaction `" + out.asJson());
+    return TestRawTransaction(out);
+}
+}  // namespace
+
 namespace toolimpl
 {
 ToolChainManager::ToolChainManager(spSetChainParamsArgs const& _config, fs::path const& _toolPath, fs::path const& _tmpDir)
@@ -18,6 +154,7 @@ ToolChainManager::ToolChainManager(spSetChainParamsArgs const& _config, fs::path
     m_maxChains = 0;
     EthereumBlockState genesis(_config->genesis(), _config->state(), FH32::zero());
     m_chains[m_currentChain] = spToolChain(new ToolChain(genesis, _config, _toolPath, _tmpDir));
+    indexBlock(m_currentChain, 0);
     m_pendingBlock =
         spEthereumBlockState(new EthereumBlockState(currentChain().lastBlock().header(), _config->state(), FH32::zero()));
     reorganizePendingBlock();
@@ -31,6 +168,7 @@ spDataObject const ToolChainManager::mineBlocks(size_t _number, ToolChain::Minin
     if (_number > 1)
         throw test::UpwardsException("ToolChainManager::mineBlocks number arg invalid: " + fto_string(_number));
     spDataObject const res = currentChainUnsafe().mineBlock(m_pendingBlock, currentChainUnsafe().lastBlock(), _req);
+    indexBlock(m_currentChain, currentChain().blocks().size() - 1);
     reorganizePendingBlock();
     return res;
 }
@@ -39,6 +177,7 @@ void ToolChainManager::rewindToBlock(VALUE const& _number)
 {
     size_t number = (size_t)_number.asBigInt();
     assert(_number.asBigInt() >= 0 && _number < currentChainUnsafe().blocks().size());
+    unindexBlocksAbove(m_currentChain, number);
     currentChainUnsafe().rewindToBlock(number);
     reorganizePendingBlock();
 }
@@ -84,12 +223,9 @@ EthereumBlockState const& ToolChainManager::blockByNumber(VALUE const& _number)
 
 EthereumBlockState const& ToolChainManager::blockByHash(FH32 const& _hash) const
 {
-    for (auto const& chain : m_chains)
-    {
-        for (auto const& block : chain.second->blocks())
-            if (block.header()->hash() == _hash)
-                return block;
-    }
+    size_t chainId, index;
+    if (findBlock(_hash, chainId, index))
+        return m_chains.at(chainId)->blocks().at(index);
     throw UpwardsException(string("ToolChainManager::blockByHash block hash not found: " + _hash.asString()));
 }
 
@@ -109,10 +245,8 @@ FH32 ToolChainManager::importRawBlock(BYTES const& _rlp)
 
         spBlockHeader header = readBlockHeader(rlp[0]);
         ETH_TEST_MESSAGE(header->asDataObject()->asJson());
-        for (auto const& chain : m_chains)
-            for (auto const& bl : chain.second->blocks())
-                if (bl.header()->hash() == header->hash())
-                    ETH_WARNING("Block with hash: `" + header->hash().asString() + "` already in chain!");
+        if (m_blockIndex.count(header->hash()))
+            ETH_WARNING("Block with hash: `" + header->hash().asString() + "` already in chain!");
 
         // Check that we know the parent and prepare head to be the parentHeader of _rlp block
         reorganizeChainForParent(header->parentHash());
@@ -169,33 +303,60 @@ FH32 ToolChainManager::importRawBlock(BYTES const& _rlp)
 
 void ToolChainManager::reorganizeChainForParent(FH32 const& _parentHash)
 {
-    for (auto const& chain : m_chains)
+    size_t chainId, i;
+    if (!findBlock(_parentHash, chainId, i))
+        throw test::UpwardsException(string("ToolChainManager:: unknown parent hash ") + _parentHash.asString());
+
+    auto const& rchain = m_chains.at(chainId).getCContent();
+    auto const& blocks = rchain.blocks();
+    if (i + 1 == blocks.size())  // last known block
+    {                            // stay on this chain
+        m_currentChain = chainId;
+        return;
+    }
+
+    // clone existing chain up to this block
+    m_chains[++m_maxChains] =
+        spToolChain(new ToolChain(blocks.at(0), rchain.params(), rchain.toolPath(), rchain.tmpDir()));
+    m_currentChain = m_maxChains;
+    indexBlock(m_currentChain, 0);
+    for (size_t j = 1; j <= i; j++)
     {
-        auto const& rchain = chain.second.getCContent();
-        auto const& blocks = chain.second->blocks();
-        for (size_t i = 0; i < blocks.size(); i++)
-        {
-            if (blocks.at(i).header()->hash() == _parentHash)
-            {
-                if (i + 1 == blocks.size())  // last known block
-                {                            // stay on this chain
-                    m_currentChain = chain.first;
-                    return;
-                }
-                else
-                {
-                    // clone existing chain up to this block
-                    m_chains[++m_maxChains] =
-                        spToolChain(new ToolChain(blocks.at(0), rchain.params(), rchain.toolPath(), rchain.tmpDir()));
-                    m_currentChain = m_maxChains;
-                    for (size_t j = 1; j <= i; j++)
-                        m_chains[m_currentChain].getContent().insertBlock(blocks.at(j));
-                    return;
-                }
-            }
-        }
+        m_chains[m_currentChain].getContent().insertBlock(blocks.at(j));
+        indexBlock(m_currentChain, j);
+    }
+}
+
+bool ToolChainManager::findBlock(FH32 const& _hash, size_t& _chainId, size_t& _index) const
+{
+    auto const it = m_blockIndex.find(_hash);
+    if (it == m_blockIndex.end() || it->second.empty())
+        return false;
+
+    // The oldest chain holding the block
+    _chainId = it->second.begin()->first;
+    _index = it->second.begin()->second;
+    return true;
+}
+
+void ToolChainManager::indexBlock(size_t _chainId, size_t _index)
+{
+    FH32 const& hash = m_chains.at(_chainId)->blocks().at(_index).header()->hash();
+    m_blockIndex[hash][_chainId] = _index;
+}
+
+void ToolChainManager::unindexBlocksAbove(size_t _chainId, size_t _number)
+{
+    auto const& blocks = m_chains.at(_chainId)->blocks();
+    for (size_t i = _number + 1; i < blocks.size(); i++)
+    {
+        auto it = m_blockIndex.find(blocks.at(i).header()->hash());
+        if (it == m_blockIndex.end())
+            continue;
+        it->second.erase(_chainId);
+        if (it->second.empty())
+            m_blockIndex.erase(it);
     }
-    throw test::UpwardsException(string("ToolChainManager:: unknown parent hash ") + _parentHash.asString());
 }
 
 void ToolChainManager::reorganizeChainForTotalDifficulty()
@@ -217,93 +378,78 @@ void ToolChainManager::reorganizeChainForTotalDifficulty()
 TestRawTransaction ToolChainManager::test_rawTransaction(
     BYTES const& _rlp, FORK const& _fork, fs::path const& _toolPath, fs::path const& _tmpDir)
 {
-    // Prepare test_mineBlocks response structure
-    DataObject out;
-    out["result"] = true;
-
-    // Prepare transaction file
-    fs::path txsPath = _tmpDir / "tx.rlp";
-
     // Rlp list header builder for given data
     test::RLPStreamU txsout(1);
-    if (_rlp.firstByte() < 128)
-    {
-        // wrap typed transactions as RLPstring in RLPStream
-        txsout.appendString(_rlp.asString());
-    }
-    else
-        txsout.appendRaw(_rlp.asString());
+    appendT9nTransaction(txsout, _rlp);
 
     // Write data with memory allocation but faster
-    writeFile(txsPath.string(), string("\"") + txsout.outHeader() + _rlp.asString().substr(2) + "\"");
-    ETH_TEST_MESSAGE("TXS file:\n" + string("\"") + txsout.outHeader() + _rlp.asString().substr(2) + "\"");
+    string const txs = txsout.outHeader() + _rlp.asString().substr(2);
+    bool errorCaught = false;
+    string const response = executeT9n(txs, _fork, _toolPath, _tmpDir);
+    spDataObject res = readT9nResponse(response, errorCaught);
 
-    string cmd = _toolPath.string();
-    cmd += " --input.txs " + txsPath.string();
-    cmd += " --state.fork " + _fork.asString();
-    cmd += " 2>&1";
-    ETH_WARNING_TEST(cmd, 6);
-    string response = test::executeCmd(cmd, ExecCMDWarning::NoWarningNoError);
+    bool const rejected = response.find("error") != string::npos || response.find("ERROR") != string::npos || errorCaught;
+    return makeRawTransactionResult(res->getSubObjects().at(0), _rlp, rejected);
+}
 
+std::vector<TestRawTransaction> ToolChainManager::test_rawTransactionBatch(
+    std::vector<spBYTES> const& _rlps, FORK const& _fork, fs::path const& _toolPath, fs::path const& _tmpDir)
+{
+    std::vector<TestRawTransaction> results;
+    if (_rlps.size() == 1)
+    {
+        results.push_back(test_rawTransaction(_rlps.at(0), _fork, _toolPath, _tmpDir));
+        return results;
+    }
 
-    ETH_TEST_MESSAGE("T9N Response:\n" + response);
-    spDataObject res;
-    bool errorCaught = false;
+    std::vector<size_t> batch;
+    for (size_t i = 0; i < _rlps.size(); i++)
+        if (isBatchSafeRlp(_rlps.at(i)))
+            batch.push_back(i);
 
-    try
+    // Tool results of the batched rlps by rlp index, the others are validated one by one
+    std::map<size_t, spDataObject> batchResults;
+    if (batch.size() > 1)
     {
-        res = dataobject::ConvertJsoncppStringToData(response);
-    }
-    catch (std::exception const& _ex) {
-        if (string(_ex.what()).find("can't read json") != string::npos)
+        test::RLPStreamU txsout(batch.size());
+        for (size_t const i : batch)
+            appendT9nTransaction(txsout, _rlps.at(i));
+
+        bool errorCaught = false;
+        string const response = executeT9n(txsout.out(), _fork, _toolPath, _tmpDir);
+        spDataObject res = readT9nResponse(response, errorCaught);
+
+        // The tool reports one error for the whole list if it could not decode it
+        bool valid = !errorCaught && res->type() == DataType::Array && res->getSubObjects().size() == batch.size();
+        for (size_t k = 0; valid && k < batch.size(); k++)
         {
-            // Unable to read json. treat response as exceptional failure on wrong input
-            ETH_WARNING("t9n returned invalid json, probably failed on input!");
-            res = spDataObject(new DataObject(DataType::Array));
-            spDataObject errObj;
-            (*errObj)["error"] = response;
-            (*res).addSubObject(errObj);
-            ETH_TEST_MESSAGE("T9N Response reconstructed:\n" + res->asJson());
-            errorCaught = true;
+            // Accepted transaction must be the one of this index
+            spDataObject const& resTr = res->getSubObjects().at(k);
+            if (!resTr->count("error") && resTr->count("hash") &&
+                resTr->atKey("hash").asString() != rawTransactionHash(_rlps.at(batch.at(k))))
+                valid = false;
         }
-        else
-            throw _ex;
-    }
 
-    string const hash = "0x" + dev::toString(dev::sha3(fromHex(_rlp.asString())));
-    spDataObject tr;
-
-    auto const& resTr = res->getSubObjects().at(0);
-    if (resTr->count("intrinsicGas"))
-    {
-        if (resTr->atKey("intrinsicGas").type() == DataType::Integer)
-            (*tr)["intrinsicGas"] = VALUE(resTr->atKey("intrinsicGas").asInt()).asString();
-        else if (resTr->atKey("intrinsicGas").type() == DataType::String)
-            (*tr)["intrinsicGas"] = VALUE(resTr->atKey("intrinsicGas").asString()).asString();
+        if (valid)
+        {
+            for (size_t k = 0; k < batch.size(); k++)
+                batchResults.emplace(batch.at(k), res->getSubObjects().at(k));
+        }
         else
-            ETH_ERROR_MESSAGE("`intrinsicGas` field type expected to be Int or String: `" + resTr->asJson());
+            ETH_LOG("t9n failed to validate transactions in batch, validating " + fto_string(batch.size()) +
+                        " transactions one by one",
+                6);
     }
-    else
-        (*tr)["intrinsicGas"] = "0x00";
 
-    if (response.find("error") != string::npos || response.find("ERROR") != string::npos || errorCaught)
-    {
-        (*tr)["error"] = resTr->atKey("error").asString();
-        (*tr)["sender"] = FH20::zero().asString();
-        (*tr)["hash"] = hash;
-        out["rejectedTransactions"].addArrayObject(tr);
-    }
-    else
+    for (size_t i = 0; i < _rlps.size(); i++)
     {
-        (*tr)["sender"] = resTr->atKey("address").asString();
-        (*tr)["hash"] = resTr->atKey("hash").asString();
-        out["acceptedTransactions"].addArrayObject(tr);
-        if (tr->atKey("hash").asString() != hash)
-            ETH_ERROR_MESSAGE("t8n tool returned different tx.hash than retesteth: (t8n.hash != retesteth.hash) " + tr->atKey("hash").asString() + " != " + hash);
+        auto const it = batchResults.find(i);
+        if (it == batchResults.end())
+            results.push_back(test_rawTransaction(_rlps.at(i), _fork, _toolPath, _tmpDir));
+        else
+            results.push_back(makeRawTransactionResult(it->second, _rlps.at(i), it->second->count("error")));
     }
-
-    ETH_TEST_MESSAGE("Response: test_rawTransaction `" + out.asJson());
-    return TestRawTransaction(out);
+    return results;
 }
 
 VALUE ToolChainManager::test_calculateDifficulty(FORK const& _fork, VALUE const& _blockNumber, VALUE const& _parentTimestamp,
@@ -338,6 +484,60 @@ VALUE ToolChainManager::test_calculateDifficulty(FORK const& _fork, VALUE const&
     return chain.lastBlock().header()->difficulty();
 }
 
+std::vector<spVALUE> ToolChainManager::test_calculateDifficultyBatch(FORK const& _fork,
+    std::vector<DifficultyRequest> const& _requests, fs::path const& _toolPath, fs::path const& _tmpDir)
+{
+    std::vector<spVALUE> result;
+    auto calculateOnTool = [&_fork, &_toolPath, &_tmpDir](DifficultyRequest const& _req) {
+        return test_calculateDifficulty(_fork, _req.blockNumber, _req.parentTimestamp, _req.parentDifficulty,
+            _req.currentTimestamp, _req.uncleNumber, _toolPath, _tmpDir);
+    };
+
+    auto const& genesisSetupInTool = Options::getCurrentConfig().getGenesisTemplate(_fork);
+    FORK const t8nForkName(genesisSetupInTool.getCContent().atKey("params").atKey("fork").asString());
+    ChainOperationParams params;
+    if (!ChainOperationParams::forkParams(t8nForkName, params))
+    {
+        for (auto const& req : _requests)
+            result.push_back(spVALUE(new VALUE(calculateOnTool(req))));
+        return result;
+    }
+
+    DifficultyStatic const& data = prepareEthereumBlockStateTemplate();
+    spBlockHeader parent = readBlockHeader(data.blockA->asDataObject());
+    spBlockHeader current = readBlockHeader(data.blockA->asDataObject());
+    BlockHeader& parentHeader = parent.getContent();
+    BlockHeader& currentHeader = current.getContent();
+    for (auto const& req : _requests)
+    {
+        if (req.blockNumber.getCContent() == 0)
+            ETH_ERROR_MESSAGE("ToolChainManager::test_calculateDifficulty calculating difficulty for blocknumber 0!");
+        parentHeader.setNumber(req.blockNumber.getCContent() - 1);
+        parentHeader.setTimestamp(req.parentTimestamp);
+        parentHeader.setDifficulty(req.parentDifficulty);
+        if (req.uncleNumber.getCContent() > 0)
+            parentHeader.setUnclesHash(FH32("0x2dcc4de8dec75d7aab85b567b6ccd41ad312451b948a7413f0a142fd40d49347"));
+        else
+            parentHeader.setUnclesHash(FH32("0x1dcc4de8dec75d7aab85b567b6ccd41ad312451b948a7413f0a142fd40d49347"));
+        currentHeader.setNumber(req.blockNumber);
+        currentHeader.setTimestamp(req.currentTimestamp);
+        result.push_back(spVALUE(new VALUE(calculateEthashDifficulty(params, currentHeader, parentHeader))));
+    }
+
+    // Sample of vectors spread over the batch (and the last one) is verified on the tool
+    size_t const step = max<size_t>(1, _requests.size() / c_difficultyToolSamples);
+    for (size_t i = 0; i < _requests.size(); i += step)
+    {
+        size_t const index = (i + step >= _requests.size()) ? _requests.size() - 1 : i;
+        VALUE const toolDifficulty = calculateOnTool(_requests.at(index));
+        if (toolDifficulty != result.at(index).getCContent())
+            ETH_ERROR_MESSAGE("tool vs retesteth difficulty disagree (" + _fork.asString() + ", vector " +
+                              fto_string(index) + "): " + toolDifficulty.asDecString() + " vs " +
+                              result.at(index)->asDecString());
+    }
+    return result;
+}
+
 
 void ToolChainManager::init1559PendingBlock(EthereumBlockState const& _lastBlock)
 {
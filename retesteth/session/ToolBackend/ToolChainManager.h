@@ -1,10 +1,12 @@
 #pragma once
 #include "ToolChain.h"
+#include <retesteth/session/SessionInterface.h>
 #include <retesteth/testStructures/types/Ethereum/EthereumBlock.h>
 #include <retesteth/testStructures/types/RPC/EthGetBlockBy.h>
 #include <retesteth/testStructures/types/RPC/SetChainParamsArgs.h>
 #include <retesteth/testStructures/types/RPC/TestRawTranasction.h>
 #include <boost/filesystem.hpp>
+#include <unordered_map>
 namespace fs = boost::filesystem;
 
 namespace toolimpl
@@ -36,11 +38,20 @@ public:
     static TestRawTransaction test_rawTransaction(
         BYTES const& _rlp, FORK const& _fork, fs::path const& _toolPath, fs::path const& _tmpDir);
 
+    // Validate transactions in one t9n run. Falls back to one run per transaction if the tool fails on the list
+    static std::vector<TestRawTransaction> test_rawTransactionBatch(
+        std::vector<spBYTES> const& _rlps, FORK const& _fork, fs::path const& _toolPath, fs::path const& _tmpDir);
+
     // Difficulty tests
     static VALUE test_calculateDifficulty(FORK const& _fork, VALUE const& _blockNumber, VALUE const& _parentTimestamp,
         VALUE const& _parentDifficulty, VALUE const& _currentTimestamp, VALUE const& _uncleNumber,
         fs::path const& _toolPath, fs::path const& _tmpDir);
 
+    // Calculate difficulty of the vectors with retesteth formula, cross check a sample of vectors with the tool
+    // Forks with unknown formula are calculated on the tool. For filling only, running the tests checks every vector on the tool
+    static std::vector<spVALUE> test_calculateDifficultyBatch(FORK const& _fork,
+        std::vector<DifficultyRequest> const& _requests, fs::path const& _toolPath, fs::path const& _tmpDir);
+
 
 private:
     ToolChainManager() {}
@@ -54,6 +65,18 @@ private:
     void reorganizeChainForTotalDifficulty();
     void reorganizePendingBlock();
 
+    // Block hash index of all chains. Cloned chains share blocks with their origin,
+    // so a hash maps to the block position in every chain that holds it
+    struct FH32Hasher
+    {
+        size_t operator()(FH32 const& _hash) const { return std::hash<string>()(_hash.asStringBytes()); }
+    };
+    typedef std::map<size_t, size_t> BlockPositions;  // chain id -> block index
+    bool findBlock(FH32 const& _hash, size_t& _chainId, size_t& _index) const;
+    void indexBlock(size_t _chainId, size_t _index);
+    void unindexBlocksAbove(size_t _chainId, size_t _number);
+    std::unordered_map<FH32, BlockPositions, FH32Hasher> m_blockIndex;
+
     std::map<size_t, spToolChain> m_chains;
     size_t m_currentChain;
     size_t m_maxChains;
@@ -1,37 +1,78 @@
 #include "ToolImplHelper.h"
 #include <retesteth/TestHelper.h>
 #include <retesteth/testStructures/Common.h>
+#include <algorithm>
 #include <mutex>
 using namespace test;
 
 namespace  {
     mutex g_DifficultyStatic_Access;
+
+    // Range cursors: nextKey is the key of the first record of the next page
+    // Account cursor is marked so that addresses 0x00 and 0x01 are not mixed with the begin/end keys
+    string const c_accountCursorMark = "0x01" + string(22, '0');
+
+    FH32 accountCursor(FH20 const& _address)
+    {
+        return FH32(c_accountCursorMark + _address.asString().substr(2));
+    }
+
+    FH32 storageCursor(VALUE const& _key)
+    {
+        return FH32(dev::toCompactHexPrefixed(dev::u256(_key.asBigInt()), 32));
+    }
+
+    std::map<FH20, spAccountBase>::const_iterator findAccountCursor(
+        std::map<FH20, spAccountBase> const& _accounts, FH32 const& _cursor)
+    {
+        // Keys without the mark start from the first account
+        string const& key = _cursor.asString();
+        if (key.compare(0, c_accountCursorMark.size(), c_accountCursorMark) != 0)
+            return _accounts.begin();
+        return _accounts.lower_bound(FH20("0x" + key.substr(c_accountCursorMark.size())));
+    }
+
+    typedef std::map<string, Storage::StorageRecord>::const_iterator StorageIterator;
+
+    // Record with the key value, or end
+    StorageIterator findStorageKey(std::map<string, Storage::StorageRecord> const& _records, VALUE const& _key)
+    {
+        auto it = _records.find(_key.asString());
+        if (it != _records.end())
+            return it;
+
+        // Records written in 0x:bigint form are not ordered by value, they are grouped by the prefix
+        static string const c_bigintPrefix = "0x:bigint ";
+        for (it = _records.lower_bound(c_bigintPrefix);
+             it != _records.end() && it->first.compare(0, c_bigintPrefix.size(), c_bigintPrefix) == 0; it++)
+        {
+            if (std::get<0>(it->second).getCContent() == _key)
+                return it;
+        }
+        return _records.end();
+    }
+
+    // Storage cursor zero is the begin/end key, it can not point to the record with key zero
+    // That record is returned first on the first page and skipped when iterating the rest
+    StorageIterator skipZeroKey(StorageIterator _it, StorageIterator _zeroKey, StorageIterator _end)
+    {
+        return (_it != _end && _it == _zeroKey) ? std::next(_it) : _it;
+    }
 }
 
 namespace toolimpl
 {
-spDataObject constructAccountRange(EthereumBlockState const& _block, FH32 const& _addrHash, size_t _maxResult)
+DebugAccountRange constructAccountRange(EthereumBlockState const& _block, FH32 const& _addrHash, size_t _maxResult)
 {
-    size_t k = 0;
-    size_t iAcc = hexOrDecStringToInt(_addrHash.asString());
-    spDataObject constructResponse;
-    spDataObject emptyList(new DataObject(DataType::Object));
-    (*constructResponse).atKeyPointer("addressMap") = emptyList;
-    for (auto const& acc : _block.state()->accounts())
-    {
-        if (k++ + 1 < iAcc)  // The first key is 1 must be included
-            continue;
-
-        spDataObject address(new DataObject(acc.first.asString()));
-        (*constructResponse)["addressMap"].addSubObject(fto_string(iAcc++), address);
-        if (constructResponse->atKey("addressMap").getSubObjects().size() == _maxResult)
-            break;
-    }
-    if (constructResponse->atKey("addressMap").getSubObjects().size() == 0)
-        (*constructResponse)["nextKey"] = test::stoCompactHexPrefixed(0, 32);
-    else
-        (*constructResponse)["nextKey"] = test::stoCompactHexPrefixed(k + 1, 32);  // because we rely on empty structure +1
-    return constructResponse;
+    auto const& accounts = _block.state()->accounts();
+    auto it = findAccountCursor(accounts, _addrHash);
+    std::vector<spFH20> addresses;
+    for (; it != accounts.end() && addresses.size() < _maxResult; it++)
+        addresses.push_back(spFH20(it->first.copy()));
+
+    if (it == accounts.end())
+        return DebugAccountRange(addresses, FH32::zero());
+    return DebugAccountRange(addresses, accountCursor(it->first));
 }
 
 spDataObject constructEthGetBlockBy(EthereumBlockState const& _block)
@@ -69,44 +110,40 @@ spDataObject constructEthGetBlockBy(EthereumBlockState const& _block)
     return constructResponse;
 }
 
-spDataObject constructStorageRangeAt(
+DebugStorageRangeAt constructStorageRangeAt(
     EthereumBlockState const& _block, FH20 const& _address, FH32 const& _begin, size_t _maxResult)
 {
-    spDataObject constructResponse;
-    if (_block.state()->hasAccount(_address))
+    if (!_block.state()->hasAccount(_address))
+        ETH_ERROR_MESSAGE("debug_storageRangeAt account not found: " + _address.asString());
+
+    std::map<string, Storage::StorageRecord> records;
+    FH32 nextKey = FH32::zero();
+    if (_block.state()->getAccount(_address).hasStorage())
     {
-        (*constructResponse)["complete"].setBool(true);
-        spDataObject obj(new DataObject(DataType::Object));
-        (*constructResponse).atKeyPointer("storage") = obj;
-        (*constructResponse)["nextKey"] = FH32::zero().asString();
-        if (_block.state()->getAccount(_address).hasStorage())
+        auto const& storage = _block.state()->getAccount(_address).storage().getKeys();
+        auto const zeroKey = findStorageKey(storage, VALUE(0));
+        StorageIterator it = storage.begin();
+        if (_begin.isZero())
         {
-            size_t iStore = 0;
-            size_t iBegin = hexOrDecStringToInt(_begin.asString());
-            for (auto const& el : _block.state()->getAccount(_address).storage().getKeys())
-            {
-                if (iStore++ + 1 < iBegin)
-                    continue;
-                DataObject& record = (*obj)[fto_string(iStore)];
-                record["key"] = std::get<0>(el.second)->asString();
-                record["value"] = std::get<1>(el.second)->asString();
-                record.performModifier(mod_removeLeadingZerosFromHexValueEVEN);
-
-                if (constructResponse->atKey("storage").getSubObjects().size() == _maxResult)
-                {
-                    (*constructResponse)["complete"].setBool(false);
-                    (*constructResponse)["nextKey"] = dev::toCompactHexPrefixed(iStore + 1, 32);
-                    break;
-                }
-            }
+            if (zeroKey != storage.end() && _maxResult > 0)
+                records.emplace(zeroKey->first, zeroKey->second);
         }
         else
         {
-            (*constructResponse)["storage"];
+            VALUE const begin(dev::bigint(_begin.asString()));
+            it = findStorageKey(storage, begin);
+            if (it == storage.end())
+                it = storage.lower_bound(begin.asString());
         }
+
+        for (it = skipZeroKey(it, zeroKey, storage.end()); it != storage.end() && records.size() < _maxResult;
+             it = skipZeroKey(std::next(it), zeroKey, storage.end()))
+            records.emplace(it->first, it->second);
+        if (it != storage.end())
+            nextKey = storageCursor(std::get<0>(it->second).getCContent());
     }
-    ETH_LOG(constructResponse->asJson(), 7);
-    return constructResponse;
+    ETH_LOG("debug_storageRangeAt records: " + fto_string(records.size()) + ", nextKey: " + nextKey.asString(), 7);
+    return DebugStorageRangeAt(spStorage(new Storage(records)), nextKey);
 }
 
 // RLP Validators
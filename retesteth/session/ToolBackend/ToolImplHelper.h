@@ -1,18 +1,20 @@
 #pragma once
 #include <retesteth/dataObject/DataObject.h>
 #include <retesteth/testStructures/types/Ethereum/EthereumBlock.h>
+#include <retesteth/testStructures/types/RPC/DebugAccountRange.h>
+#include <retesteth/testStructures/types/RPC/DebugStorageRangeAt.h>
 using namespace dataobject;
 
 namespace toolimpl
 {
-// Construct accountRange RPC style
-spDataObject constructAccountRange(EthereumBlockState const& _block, FH32 const& _addrHash, size_t _maxResult);
+// Construct accountRange response
+DebugAccountRange constructAccountRange(EthereumBlockState const& _block, FH32 const& _addrHash, size_t _maxResult);
 
-// Construct storageRange RPC style
-spDataObject constructStorageRangeAt(
+// Construct storageRange response
+DebugStorageRangeAt constructStorageRangeAt(
     EthereumBlockState const& _block, FH20 const& _address, FH32 const& _begin, size_t _maxResult);
 
-// Construct RPC style response
+// Construct RPC style json of the block, for logs
 spDataObject constructEthGetBlockBy(EthereumBlockState const& _block);
 
 // RLP Validators
@@ -0,0 +1,86 @@
+#include "ToolLibrary.h"
+#include <retesteth/EthChecks.h>
+#include <retesteth/TestHelper.h>
+#include <dlfcn.h>
+#include <map>
+#include <memory>
+#include <mutex>
+
+using namespace std;
+using namespace test;
+
+namespace
+{
+std::mutex g_toolLibrariesMutex;
+std::map<string, std::unique_ptr<toolimpl::ToolLibrary>> g_toolLibraries;
+}  // namespace
+
+namespace toolimpl
+{
+ToolLibrary& ToolLibrary::get(fs::path const& _libPath)
+{
+    std::lock_guard<std::mutex> lock(g_toolLibrariesMutex);
+    auto it = g_toolLibraries.find(_libPath.string());
+    if (it == g_toolLibraries.end())
+    {
+        std::unique_ptr<ToolLibrary> library(new ToolLibrary(_libPath));
+        it = g_toolLibraries.emplace(_libPath.string(), std::move(library)).first;
+    }
+    return *it->second;
+}
+
+ToolLibrary::ToolLibrary(fs::path const& _libPath) : m_libPath(_libPath)
+{
+    m_handle = dlopen(m_libPath.c_str(), RTLD_NOW | RTLD_LOCAL);
+    if (!m_handle)
+        ETH_FAIL_MESSAGE("ToolLibrary failed to load: " + m_libPath.string() + " (" + dlerror() + ")");
+
+    auto abiVersion = (t8n_abi_version_fn)loadSymbol("t8n_abi_version");
+    if (abiVersion() != T8N_ABI_VERSION)
+        ETH_FAIL_MESSAGE("ToolLibrary ABI version mismatch: " + m_libPath.string() + " has `" +
+                         fto_string(abiVersion()) + "`, expected `" + fto_string(T8N_ABI_VERSION) + "`");
+    m_version = (t8n_version_fn)loadSymbol("t8n_version");
+    m_apply = (t8n_apply_fn)loadSymbol("t8n_apply");
+    m_free = (t8n_free_fn)loadSymbol("t8n_free");
+    ETH_LOG("ToolLibrary loaded: " + m_libPath.string() + " " + version(), 6);
+}
+
+void* ToolLibrary::loadSymbol(char const* _name) const
+{
+    void* symbol = dlsym(m_handle, _name);
+    if (!symbol)
+        ETH_FAIL_MESSAGE("ToolLibrary " + m_libPath.string() + " does not export `" + _name + "`");
+    return symbol;
+}
+
+string ToolLibrary::version() const
+{
+    char const* version = m_version();
+    return version ? string(version) : string();
+}
+
+string ToolLibrary::apply(
+    string const& _args, string const& _alloc, string const& _env, string const& _txs, bool _txsRlp) const
+{
+    char* result = nullptr;
+    char* outAlloc = nullptr;
+    int const code =
+        m_apply(_args.c_str(), _alloc.c_str(), _env.c_str(), _txs.c_str(), _txsRlp ? 1 : 0, &result, &outAlloc);
+
+    string const resultStr = result ? string(result) : string();
+    string const outAllocStr = outAlloc ? string(outAlloc) : string();
+    if (result)
+        m_free(result);
+    if (outAlloc)
+        m_free(outAlloc);
+
+    if (code != 0)
+    {
+        ETH_ERROR_MESSAGE("ToolLibrary " + m_libPath.string() + " returned error code `" + fto_string(code) +
+                          "`: " + resultStr);
+        return string();
+    }
+    return "{\"result\":" + resultStr + ",\"alloc\":" + outAllocStr + "}";
+}
+
+}  // namespace toolimpl
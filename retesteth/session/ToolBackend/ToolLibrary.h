@@ -0,0 +1,34 @@
+#pragma once
+#include "ToolLibraryABI.h"
+#include <boost/filesystem.hpp>
+#include <string>
+namespace fs = boost::filesystem;
+
+namespace toolimpl
+{
+// Transition library loaded into retesteth process (see ToolLibraryABI.h)
+// Library is loaded once per path and shared by all sessions, it is never unloaded
+class ToolLibrary
+{
+public:
+    static ToolLibrary& get(fs::path const& _libPath);
+
+    // Library version string
+    std::string version() const;
+
+    // Apply the transition, return {"result" : {..}, "alloc" : {..}} as the t8ntool stdout response
+    std::string apply(std::string const& _args, std::string const& _alloc, std::string const& _env,
+        std::string const& _txs, bool _txsRlp) const;
+
+private:
+    ToolLibrary(fs::path const& _libPath);
+    void* loadSymbol(char const* _name) const;
+
+    fs::path m_libPath;
+    void* m_handle = nullptr;
+    t8n_version_fn m_version = nullptr;
+    t8n_apply_fn m_apply = nullptr;
+    t8n_free_fn m_free = nullptr;
+};
+
+}  // namespace toolimpl
@@ -0,0 +1,25 @@
+#pragma once
+// C ABI of the in-process transition library (socketType "transition-library")
+// The library implements the same contract as t8ntool with stdin/stdout io:
+//   _args    t8n arguments (--state.fork <fork> --state.reward <reward> --output.basedir <dir> ...)
+//   _alloc   alloc json, _env env json
+//   _txs     txs json array, or rlp string in quotes when _txsRlp != 0
+//   _result  result json of the transition (on error: the error message)
+//   _outAlloc post state alloc json
+// Strings returned by the library are released with t8n_free
+// Functions are called concurrently from the test threads, so the library must be reentrant
+#define T8N_ABI_VERSION 1
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef int (*t8n_abi_version_fn)();
+typedef char const* (*t8n_version_fn)();
+typedef int (*t8n_apply_fn)(char const* _args, char const* _alloc, char const* _env, char const* _txs, int _txsRlp,
+    char** _result, char** _outAlloc);
+typedef void (*t8n_free_fn)(char* _str);
+
+#ifdef __cplusplus
+}
+#endif
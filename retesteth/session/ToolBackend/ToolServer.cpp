@@ -0,0 +1,139 @@
+#include "ToolServer.h"
+#include <retesteth/EthChecks.h>
+#include <retesteth/TestHelper.h>
+#include <algorithm>
+#include <cerrno>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <signal.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+using namespace std;
+using namespace test;
+
+namespace
+{
+std::mutex g_toolServersMutex;
+std::map<string, std::unique_ptr<toolimpl::ToolServer>> g_toolServers;
+}  // namespace
+
+namespace toolimpl
+{
+ToolServer& ToolServer::get(fs::path const& _serverPath, fs::path const& _tmpDir)
+{
+    std::lock_guard<std::mutex> lock(g_toolServersMutex);
+    auto it = g_toolServers.find(_tmpDir.string());
+    if (it == g_toolServers.end())
+    {
+        std::unique_ptr<ToolServer> server(new ToolServer(_serverPath));
+        it = g_toolServers.emplace(_tmpDir.string(), std::move(server)).first;
+    }
+    return *it->second;
+}
+
+void ToolServer::release(fs::path const& _tmpDir)
+{
+    std::lock_guard<std::mutex> lock(g_toolServersMutex);
+    g_toolServers.erase(_tmpDir.string());
+}
+
+ToolServer::ToolServer(fs::path const& _serverPath) : m_serverPath(_serverPath)
+{
+    start();
+}
+
+ToolServer::~ToolServer()
+{
+    stop();
+}
+
+void ToolServer::start()
+{
+    // exec so that the server replaces the shell and the pid is the server's own
+    string path = m_serverPath.string();
+    size_t pos = 0;
+    while ((pos = path.find('\'', pos)) != string::npos)
+    {
+        path.replace(pos, 1, "'\\''");
+        pos += 4;
+    }
+    m_cmd = SpawnServer::spawn("exec '" + path + "'", true);
+    m_readBuffer.clear();
+    ETH_LOG("ToolServer started: " + m_serverPath.string() + " pid: " + fto_string(m_cmd.pid), 6);
+}
+
+void ToolServer::stop()
+{
+    if (m_cmd.pid != 0)
+    {
+        // the server could be busy or have children of its own, stop the whole group
+        kill(-m_cmd.pid, SIGTERM);
+        SpawnServer::wait(m_cmd);
+        m_cmd = SpawnedCmd();
+    }
+}
+
+void ToolServer::sendAll(string const& _data)
+{
+    size_t sent = 0;
+    while (sent < _data.size())
+    {
+        ssize_t const res = send(m_cmd.fdIn, _data.data() + sent, _data.size() - sent, MSG_NOSIGNAL);
+        if (res == -1 && errno == EINTR)
+            continue;
+        if (res <= 0)
+            throw test::UpwardsException("ToolServer failed to send the request: " + m_serverPath.string());
+        sent += (size_t)res;
+    }
+}
+
+string ToolServer::readLine()
+{
+    char buffer[65536];
+    size_t pos = m_readBuffer.find('\n');
+    while (pos == string::npos)
+    {
+        ssize_t const res = read(m_cmd.fdOut, buffer, sizeof(buffer));
+        if (res == -1 && errno == EINTR)
+            continue;
+        if (res <= 0)
+            throw test::UpwardsException("ToolServer closed the connection: " + m_serverPath.string());
+        size_t const searchFrom = m_readBuffer.size();
+        m_readBuffer.append(buffer, (size_t)res);
+        pos = m_readBuffer.find('\n', searchFrom);
+    }
+    string line = m_readBuffer.substr(0, pos);
+    m_readBuffer.erase(0, pos + 1);
+    return line;
+}
+
+string ToolServer::request(string const& _args, string const& _input)
+{
+    // The protocol is line based. Input must not contain line breaks
+    string message = _args + "\n" + _input;
+    std::replace(message.begin() + _args.size() + 1, message.end(), '\n', ' ');
+    message += "\n";
+
+    // Restart the server once if it died since the previous request
+    for (size_t attempt = 0; attempt < 2; attempt++)
+    {
+        try
+        {
+            if (m_cmd.pid == 0)
+                start();
+            sendAll(message);
+            return readLine();
+        }
+        catch (test::UpwardsException const& _ex)
+        {
+            ETH_WARNING(_ex.what());
+            stop();
+        }
+    }
+    ETH_ERROR_MESSAGE("ToolServer failed to process the request: " + m_serverPath.string());
+    return string();
+}
+
+}  // namespace toolimpl
@@ -0,0 +1,45 @@
+#pragma once
+#include <retesteth/SpawnServer.h>
+#include <boost/filesystem.hpp>
+#include <string>
+namespace fs = boost::filesystem;
+
+namespace toolimpl
+{
+// Persistent t8ntool process that serves transition requests on its stdin/stdout
+// Instead of spawning the tool for each block, one server process is kept alive per session
+// The server must be a long lived tool implementation that serves many requests (set "toolServer" in config)
+// A script that runs `evm t8n` per request gains nothing over spawning the tool for each block
+//
+// The process is launched via SpawnServer in its own process group
+//
+// Protocol (line based, the server reads requests from stdin and writes responses to stdout):
+//   request:  line 1  t8n arguments (--state.fork <fork> --state.reward <reward> --output.basedir <dir> ...)
+//             line 2  {"alloc" : {..}, "env" : {..}, "txsRlp" : "0x.."} in one line
+//   response: line 1  {"result" : {..}, "alloc" : {..}} in one line
+class ToolServer
+{
+public:
+    // Get the server bound to the session tmp directory. Starts the server process if not running
+    static ToolServer& get(fs::path const& _serverPath, fs::path const& _tmpDir);
+
+    // Stop the server bound to the session tmp directory (on session close)
+    static void release(fs::path const& _tmpDir);
+
+    // Send the request to the server and wait for its response line
+    std::string request(std::string const& _args, std::string const& _input);
+    ~ToolServer();
+
+private:
+    ToolServer(fs::path const& _serverPath);
+    void start();
+    void stop();
+    void sendAll(std::string const& _data);
+    std::string readLine();
+
+    fs::path m_serverPath;
+    test::SpawnedCmd m_cmd;
+    std::string m_readBuffer;
+};
+
+}  // namespace toolimpl
@@ -0,0 +1,291 @@
+#include "ToolStateReader.h"
+#include <retesteth/EthChecks.h>
+#include <retesteth/TestHelper.h>
+#include <cctype>
+
+using namespace std;
+using namespace test;
+using namespace test::teststruct;
+using namespace dataobject;
+
+namespace
+{
+// Minimal json reader over the range of the tool output string
+// Tool alloc consist of hex strings only, so strings are read raw without unescaping
+class JsonCursor
+{
+public:
+    JsonCursor(string const& _json, size_t _begin, size_t _end) : m_json(_json), m_pos(_begin), m_end(_end) {}
+
+    size_t pos() const { return m_pos; }
+    void skipSpaces()
+    {
+        while (m_pos < m_end && isspace((unsigned char)m_json[m_pos]))
+            m_pos++;
+    }
+
+    bool tryRead(char _c)
+    {
+        skipSpaces();
+        if (m_pos < m_end && m_json[m_pos] == _c)
+        {
+            m_pos++;
+            return true;
+        }
+        return false;
+    }
+
+    void expect(char _c)
+    {
+        if (!tryRead(_c))
+            error(string("expected `") + _c + "`");
+    }
+
+    void expectEnd()
+    {
+        skipSpaces();
+        if (m_pos != m_end)
+            error("expected end of json");
+    }
+
+    string readString()
+    {
+        expect('"');
+        size_t const begin = m_pos;
+        while (m_pos < m_end && m_json[m_pos] != '"')
+            m_pos += (m_json[m_pos] == '\\') ? 2 : 1;
+        if (m_pos >= m_end)
+            error("not found string ending char: `\"`");
+        return m_json.substr(begin, m_pos++ - begin);
+    }
+
+    void skipValue()
+    {
+        skipSpaces();
+        if (m_pos >= m_end)
+            error("unexpected end of json");
+
+        char const c = m_json[m_pos];
+        if (c == '"')
+        {
+            readString();
+            return;
+        }
+        if (c == '{' || c == '[')
+        {
+            size_t depth = 0;
+            while (m_pos < m_end)
+            {
+                char const e = m_json[m_pos];
+                if (e == '"')
+                {
+                    readString();
+                    continue;
+                }
+                if (e == '{' || e == '[')
+                    depth++;
+                else if (e == '}' || e == ']')
+                {
+                    if (--depth == 0)
+                    {
+                        m_pos++;
+                        return;
+                    }
+                }
+                m_pos++;
+            }
+            error("not found closing of the object/array");
+        }
+
+        // number, bool or null
+        while (m_pos < m_end && m_json[m_pos] != ',' && m_json[m_pos] != '}' && m_json[m_pos] != ']' &&
+               !isspace((unsigned char)m_json[m_pos]))
+            m_pos++;
+    }
+
+    [[noreturn]] void error(string const& _what) const
+    {
+        size_t const from = m_pos > 60 ? m_pos - 60 : 0;
+        throw UpwardsException("Error parsing tool alloc: " + _what + " around: \n" + m_json.substr(from, 120));
+    }
+
+private:
+    string const& m_json;
+    size_t m_pos;
+    size_t m_end;
+};
+
+// Read hex value from the tool output
+// Storage keys and values may have leading zeros, balance and nonce follow the VALUE rule (0x0, 0x00, 0x01 but not 0x001)
+spVALUE readToolValue(string const& _str, string const& _field, bool _allowLeadingZeros)
+{
+    if (_str.size() < 3 || _str[0] != '0' || _str[1] != 'x')
+        throw UpwardsException("VALUE is not prefixed hex `" + _str + "` (key: " + _field + " )");
+
+    size_t const size = _str.size();
+    if (!_allowLeadingZeros && _str[2] == '0' &&
+        ((size % 2 == 1 && size != 3) || (size % 2 == 0 && size > 4 && _str[3] == '0')))
+        throw UpwardsException("VALUE has leading 0 `" + _str + "` (key: " + _field + " )");
+
+    size_t firstDigit = 2;
+    while (firstDigit + 1 < _str.size() && _str[firstDigit] == '0')
+        firstDigit++;
+    if (_str.size() - firstDigit > 64)
+        throw UpwardsException("VALUE  >u256 `" + _str + "` (key: " + _field + " )");
+    for (size_t i = firstDigit; i < _str.size(); i++)
+        if (!isxdigit((unsigned char)_str[i]))
+            throw UpwardsException("VALUE is not a hex string `" + _str + "` (key: " + _field + " )");
+
+    return spVALUE(new VALUE(dev::bigint(_str)));
+}
+
+// Return the number of records shared with _parent storage
+size_t readToolStorage(
+    JsonCursor& _cursor, std::map<string, Storage::StorageRecord>& _records, Storage const* _parent)
+{
+    size_t sharedRecords = 0;
+    _cursor.expect('{');
+    if (_cursor.tryRead('}'))
+        return sharedRecords;
+    do
+    {
+        spVALUE key = readToolValue(_cursor.readString(), "Storage record in storage", true);
+        _cursor.expect(':');
+        spVALUE value = readToolValue(_cursor.readString(), key->asString(), true);
+        string const& keyStr = key->asString();
+        if (_parent && _parent->getKeys().count(keyStr))
+        {
+            Storage::StorageRecord const& parentRecord = _parent->getKeys().at(keyStr);
+            if (std::get<1>(parentRecord).getCContent() == value.getCContent())
+            {
+                _records[keyStr] = parentRecord;
+                sharedRecords++;
+                continue;
+            }
+        }
+        _records[keyStr] = {key, value};
+    } while (_cursor.tryRead(','));
+    _cursor.expect('}');
+    return sharedRecords;
+}
+
+spAccountBase readToolAccount(JsonCursor& _cursor, FH20 const& _address, spAccountBase const* _parent)
+{
+    spVALUE balance(new VALUE(0));
+    spVALUE nonce(new VALUE(0));
+    string code = "0x";
+    std::map<string, Storage::StorageRecord> records;
+    size_t sharedRecords = 0;
+    Storage const* parentStorage =
+        (_parent && (*_parent)->hasStorage()) ? &(*_parent)->storage() : nullptr;
+
+    _cursor.expect('{');
+    if (!_cursor.tryRead('}'))
+    {
+        do
+        {
+            string const field = _cursor.readString();
+            _cursor.expect(':');
+            if (field == "balance")
+                balance = readToolValue(_cursor.readString(), field, false);
+            else if (field == "nonce")
+                nonce = readToolValue(_cursor.readString(), field, false);
+            else if (field == "code")
+                code = _cursor.readString();
+            else if (field == "storage")
+                sharedRecords = readToolStorage(_cursor, records, parentStorage);
+            else
+                _cursor.skipValue();
+        } while (_cursor.tryRead(','));
+        _cursor.expect('}');
+    }
+
+    if (_parent)
+    {
+        AccountBase const& parent = *_parent;
+        bool const sameCode = parent.code().asString() == code;
+        bool const sameStorage = parentStorage ? (sharedRecords == records.size() &&
+                                                     records.size() == parentStorage->getKeys().size()) :
+                                                 records.size() == 0;
+        if (sameCode && sameStorage && parent.balance() == balance.getCContent() &&
+            parent.nonce() == nonce.getCContent())
+            return *_parent;
+
+        if (sameCode)
+        {
+            spBYTES spCode = parent.codePtr();
+            spStorage storage(new Storage(records));
+            return spAccountBase(new State::Account(_address, balance, nonce, spCode, storage));
+        }
+    }
+
+    spBYTES spCode(new BYTES(DataObject(code)));
+    spStorage storage(new Storage(records));
+    return spAccountBase(new State::Account(_address, balance, nonce, spCode, storage));
+}
+
+}  // namespace
+
+namespace toolimpl
+{
+State readToolAlloc(string const& _json, State const* _parent)
+{
+    return readToolAlloc(_json, 0, _json.size(), _parent);
+}
+
+State readToolAlloc(string const& _json, size_t _begin, size_t _end, State const* _parent)
+{
+    std::map<FH20, spAccountBase> accounts;
+    try
+    {
+        JsonCursor cursor(_json, _begin, _end);
+        cursor.expect('{');
+        if (!cursor.tryRead('}'))
+        {
+            do
+            {
+                FH20 const address(cursor.readString());
+                cursor.expect(':');
+                spAccountBase const* parentAccount = nullptr;
+                if (_parent && _parent->hasAccount(address))
+                    parentAccount = &_parent->accounts().at(address);
+                accounts.emplace(address, readToolAccount(cursor, address, parentAccount));
+            } while (cursor.tryRead(','));
+            cursor.expect('}');
+        }
+        cursor.expectEnd();
+    }
+    catch (std::exception const& _ex)
+    {
+        throw UpwardsException(string("State parse error: ") + _ex.what());
+    }
+
+    if (accounts.size() == 0)
+        throw UpwardsException("State parse error: State must have at least one record!");
+    return State(accounts);
+}
+
+bool findJsonTopLevelValue(string const& _json, string const& _key, size_t& _begin, size_t& _end)
+{
+    JsonCursor cursor(_json, 0, _json.size());
+    cursor.expect('{');
+    if (cursor.tryRead('}'))
+        return false;
+    do
+    {
+        string const key = cursor.readString();
+        cursor.expect(':');
+        cursor.skipSpaces();
+        size_t const begin = cursor.pos();
+        cursor.skipValue();
+        if (key == _key)
+        {
+            _begin = begin;
+            _end = cursor.pos();
+            return true;
+        }
+    } while (cursor.tryRead(','));
+    return false;
+}
+
+}  // namespace toolimpl
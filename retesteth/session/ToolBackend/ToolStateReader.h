@@ -0,0 +1,18 @@
+#pragma once
+#include <retesteth/testStructures/types/Ethereum/State.h>
+#include <string>
+
+namespace toolimpl
+{
+// Read t8ntool alloc json straight into the State in one pass without building the DataObject tree
+// Because tool report incomplete state, missing fields are restored with zeros
+// Leading zeros are removed from storage keys and values
+// Accounts, code and storage records that did not change since the _parent state are shared with it
+test::teststruct::State readToolAlloc(std::string const& _json, test::teststruct::State const* _parent = nullptr);
+test::teststruct::State readToolAlloc(
+    std::string const& _json, size_t _begin, size_t _end, test::teststruct::State const* _parent = nullptr);
+
+// Find the value of a top level _key in json object. Set [_begin, _end) range of the value
+bool findJsonTopLevelValue(std::string const& _json, std::string const& _key, size_t& _begin, size_t& _end);
+
+}  // namespace toolimpl
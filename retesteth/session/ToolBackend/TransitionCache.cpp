@@ -0,0 +1,237 @@
+#include "TransitionCache.h"
+#include "ToolLibrary.h"
+#include <Options.h>
+#include <libdevcore/CommonIO.h>
+#include <libdevcore/SHA3.h>
+#include <cstdint>
+#include <ctime>
+#include <map>
+#include <mutex>
+
+using namespace std;
+using namespace test;
+using namespace dev;
+
+namespace
+{
+struct CacheRecord
+{
+    size_t size;
+    uint64_t lastUse;  // value of g_cacheUseCounter at the last use
+};
+
+std::mutex g_transitionCacheMutex;
+std::map<string, CacheRecord> g_cacheIndex;
+std::map<string, string> g_toolVersions;
+size_t g_cacheTotalSize = 0;
+uint64_t g_cacheUseCounter = 0;  // monotonic use order, file mtime has 1 second resolution
+bool g_cacheLoaded = false;
+toolimpl::TransitionCacheStats g_cacheStats;
+
+fs::path cacheFolder()
+{
+    return Options::get().toolCacheDir.get() / "t8n";
+}
+
+fs::path cacheRecordPath(string const& _key)
+{
+    return cacheFolder() / (_key + ".json");
+}
+
+size_t cacheSizeLimit()
+{
+    return Options::get().toolCacheSizeMB * 1024 * 1024;
+}
+
+// Index the records of the previous runs. Called under the mutex
+void loadCacheIndex()
+{
+    g_cacheLoaded = true;
+    fs::path const folder = cacheFolder();
+    if (!fs::exists(folder))
+    {
+        fs::create_directories(folder);
+        return;
+    }
+
+    // Records of the previous runs are ordered by mtime, then they get use counter values
+    std::multimap<std::time_t, std::pair<string, size_t>> byLastWrite;
+    for (auto const& file : fs::directory_iterator(folder))
+    {
+        if (file.path().extension() != ".json")
+            continue;
+        boost::system::error_code ec;
+        size_t const size = fs::file_size(file.path(), ec);
+        std::time_t const lastWrite = fs::last_write_time(file.path(), ec);
+        if (ec)
+            continue;
+        byLastWrite.emplace(lastWrite, std::make_pair(file.path().stem().string(), size));
+    }
+    for (auto const& el : byLastWrite)
+    {
+        g_cacheIndex[el.second.first] = {el.second.second, ++g_cacheUseCounter};
+        g_cacheTotalSize += el.second.second;
+    }
+    ETH_LOG("TransitionCache indexed " + fto_string(g_cacheIndex.size()) + " records in " + folder.string(), 6);
+}
+
+// Remove least recently used records until the cache is under 90% of the limit. Called under the mutex
+void evictRecords()
+{
+    size_t const limit = cacheSizeLimit();
+    if (g_cacheTotalSize <= limit)
+        return;
+
+    std::map<uint64_t, string> byLastUse;
+    for (auto const& el : g_cacheIndex)
+        byLastUse.emplace(el.second.lastUse, el.first);
+
+    size_t const target = limit / 10 * 9;
+    for (auto const& el : byLastUse)
+    {
+        if (g_cacheTotalSize <= target)
+            break;
+        boost::system::error_code ec;
+        fs::remove(cacheRecordPath(el.second), ec);
+        g_cacheTotalSize -= g_cacheIndex.at(el.second).size;
+        g_cacheIndex.erase(el.second);
+        g_cacheStats.evictions++;
+    }
+}
+
+}  // namespace
+
+namespace toolimpl
+{
+// Tool version is part of the key, so updating the tool invalidates the records
+string TransitionCache::toolVersion(fs::path const& _toolPath)
+{
+    {
+        std::lock_guard<std::mutex> lock(g_transitionCacheMutex);
+        auto const it = g_toolVersions.find(_toolPath.string());
+        if (it != g_toolVersions.end())
+            return it->second;
+    }
+    bool const isLibrary =
+        Options::getCurrentConfig().cfgFile().socketType() == teststruct::ClientConfgSocketType::TransitionLibrary;
+    string const version = isLibrary ? toolimpl::ToolLibrary::get(_toolPath).version() :
+                                       test::executeCmd(_toolPath.string() + " -v", ExecCMDWarning::NoWarningNoError);
+    std::lock_guard<std::mutex> lock(g_transitionCacheMutex);
+    g_toolVersions.emplace(_toolPath.string(), version);
+    return version;
+}
+
+bool TransitionCache::enabled()
+{
+    return Options::get().toolCacheDir.is_initialized() && Options::get().toolCacheSizeMB > 0;
+}
+
+string TransitionCache::makeKey(fs::path const& _toolPath, string const& _args, string const& _input)
+{
+    string const content = _toolPath.string() + "\n" + toolVersion(_toolPath) + "\n" + _args + "\n" + _input;
+    return dev::toString(dev::sha3(content));
+}
+
+bool TransitionCache::find(string const& _key, string& _response)
+{
+    {
+        std::lock_guard<std::mutex> lock(g_transitionCacheMutex);
+        if (!g_cacheLoaded)
+            loadCacheIndex();
+        if (!g_cacheIndex.count(_key))
+        {
+            g_cacheStats.misses++;
+            return false;
+        }
+    }
+
+    // Records are only replaced by rename, so they are read without holding the mutex
+    fs::path const record = cacheRecordPath(_key);
+    _response = dev::contentsString(record);
+    if (!_response.empty())
+    {
+        // Touch the record so it survives eviction in the next runs as well
+        boost::system::error_code ec;
+        fs::last_write_time(record, std::time(nullptr), ec);
+    }
+
+    std::lock_guard<std::mutex> lock(g_transitionCacheMutex);
+    auto it = g_cacheIndex.find(_key);
+    if (!_response.empty())
+    {
+        if (it != g_cacheIndex.end())
+            it->second.lastUse = ++g_cacheUseCounter;
+        g_cacheStats.hits++;
+        return true;
+    }
+
+    // Record was removed by eviction or by another retesteth instance
+    if (it != g_cacheIndex.end())
+    {
+        g_cacheTotalSize -= it->second.size;
+        g_cacheIndex.erase(it);
+    }
+    g_cacheStats.misses++;
+    return false;
+}
+
+void TransitionCache::insert(string const& _key, string const& _response)
+{
+    {
+        std::lock_guard<std::mutex> lock(g_transitionCacheMutex);
+        if (!g_cacheLoaded)
+            loadCacheIndex();
+        if (g_cacheIndex.count(_key))
+            return;
+    }
+
+    // Write to a temporary file first, so a parallel reader never sees a partial record
+    fs::path const record = cacheRecordPath(_key);
+    fs::path const tmpRecord = cacheFolder() / fs::unique_path(_key + ".%%%%%%.tmp");
+    writeFile(tmpRecord, _response);
+    boost::system::error_code ec;
+    fs::rename(tmpRecord, record, ec);
+    if (ec)
+    {
+        fs::remove(tmpRecord, ec);
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(g_transitionCacheMutex);
+    if (g_cacheIndex.count(_key))
+        return;
+    g_cacheIndex[_key] = {_response.size(), ++g_cacheUseCounter};
+    g_cacheTotalSize += _response.size();
+    g_cacheStats.stores++;
+    evictRecords();
+}
+
+void TransitionCache::printStats()
+{
+    if (!enabled())
+        return;
+    std::lock_guard<std::mutex> lock(g_transitionCacheMutex);
+    string const message = "*** TransitionCache: hits " + fto_string(g_cacheStats.hits) + ", misses " +
+                           fto_string(g_cacheStats.misses) + ", stored " + fto_string(g_cacheStats.stores) +
+                           ", evicted " + fto_string(g_cacheStats.evictions) + ", size " +
+                           fto_string(g_cacheTotalSize / 1024) + "KB";
+    ETH_STDOUT_MESSAGE(message);
+}
+
+TransitionCacheStats TransitionCache::stats()
+{
+    std::lock_guard<std::mutex> lock(g_transitionCacheMutex);
+    return g_cacheStats;
+}
+
+void TransitionCache::reset()
+{
+    std::lock_guard<std::mutex> lock(g_transitionCacheMutex);
+    g_cacheIndex.clear();
+    g_cacheTotalSize = 0;
+    g_cacheUseCounter = 0;
+    g_cacheLoaded = false;
+    g_cacheStats = TransitionCacheStats();
+}
+
+}  // namespace toolimpl
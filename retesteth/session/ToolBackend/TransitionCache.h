@@ -0,0 +1,42 @@
+#pragma once
+#include <boost/filesystem.hpp>
+#include <string>
+namespace fs = boost::filesystem;
+
+namespace toolimpl
+{
+struct TransitionCacheStats
+{
+    size_t hits = 0;
+    size_t misses = 0;
+    size_t stores = 0;
+    size_t evictions = 0;
+};
+
+// On-disk memoization of t8ntool results, enabled with `--toolcache <dir>`
+// The key is a hash of (tool version, t8n arguments, env, alloc, txs) and the value is
+// the tool output {"result" : {..}, "alloc" : {..}}. Refilling unchanged tests replays the
+// stored results instead of running the tool. Records are kept in <dir>/t8n/<key>.json,
+// the least recently used records are evicted when the folder grows over `--toolcachesize`
+class TransitionCache
+{
+public:
+    static bool enabled();
+    static std::string makeKey(fs::path const& _toolPath, std::string const& _args, std::string const& _input);
+
+    // Version string reported by the tool (`<tool> -v`), remembered for the run
+    static std::string toolVersion(fs::path const& _toolPath);
+
+    // Return true and set _response if the key is known
+    static bool find(std::string const& _key, std::string& _response);
+    static void insert(std::string const& _key, std::string const& _response);
+
+    // Print hits/misses/evictions at the end of the run
+    static void printStats();
+    static TransitionCacheStats stats();
+
+    // Forget the loaded index, so it is read again from the current `--toolcache` folder
+    static void reset();
+};
+
+}  // namespace toolimpl
@@ -0,0 +1,90 @@
+/*
+    Reference transition library for socketType "transition-library" (see ToolLibraryABI.h)
+    Performs a no-op transition: the post state is the input alloc, no transactions are executed
+    Used by unit tests to check the library backend without a real EVM implementation
+*/
+#include <stdlib.h>
+#include <string.h>
+
+#define T8N_STUB_ZERO32 "\"0x0000000000000000000000000000000000000000000000000000000000000000\""
+
+static char* copyString(char const* _str)
+{
+    size_t const size = strlen(_str) + 1;
+    char* res = (char*)malloc(size);
+    if (res)
+        memcpy(res, _str, size);
+    return res;
+}
+
+static char* makeLogsBloom()
+{
+    // "0x" + 256 zero bytes in quotes
+    size_t const size = 2 + 2 + 512 + 1;
+    char* res = (char*)malloc(size);
+    if (!res)
+        return res;
+    memset(res, '0', size - 1);
+    res[0] = '"';
+    res[2] = 'x';
+    res[size - 2] = '"';
+    res[size - 1] = 0;
+    return res;
+}
+
+int t8n_abi_version()
+{
+    return 1;
+}
+
+char const* t8n_version()
+{
+    return "t8nstub 1.0.0";
+}
+
+int t8n_apply(char const* _args, char const* _alloc, char const* _env, char const* _txs, int _txsRlp, char** _result,
+    char** _outAlloc)
+{
+    (void)_args;
+    (void)_env;
+    (void)_txs;
+    (void)_txsRlp;
+    *_result = NULL;
+    *_outAlloc = NULL;
+    if (!_alloc)
+    {
+        *_result = copyString("t8nstub: alloc is not provided");
+        return 1;
+    }
+
+    char* logsBloom = makeLogsBloom();
+    if (!logsBloom)
+        return 2;
+
+    static char const* const fmt = "{\"stateRoot\":" T8N_STUB_ZERO32 ",\"txRoot\":" T8N_STUB_ZERO32
+                                   ",\"receiptsRoot\":" T8N_STUB_ZERO32 ",\"logsHash\":" T8N_STUB_ZERO32
+                                   ",\"logsBloom\":%s,\"currentDifficulty\":null,\"receipts\":[],"
+                                   "\"rejected\":[],\"gasUsed\":\"0x0\"}";
+    size_t const size = strlen(fmt) + strlen(logsBloom) + 1;
+    char* result = (char*)malloc(size);
+    if (!result)
+    {
+        free(logsBloom);
+        return 2;
+    }
+    char const* pos = strstr(fmt, "%s");
+    size_t const prefix = (size_t)(pos - fmt);
+    memcpy(result, fmt, prefix);
+    strcpy(result + prefix, logsBloom);
+    strcat(result, pos + 2);
+    free(logsBloom);
+
+    *_result = result;
+    *_outAlloc = copyString(_alloc);
+    return 0;
+}
+
+void t8n_free(char* _str)
+{
+    free(_str);
+}
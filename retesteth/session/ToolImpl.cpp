@@ -1,4 +1,5 @@
 #include <cstdio>
+#include <map>
 #include <thread>
 
 #include <dataObject/ConvertFile.h>
@@ -9,6 +10,7 @@
 #include <retesteth/testStructures/types/Ethereum/TransactionReader.h>
 
 #include "ToolBackend/ToolImplHelper.h"
+#include "ToolBackend/ToolServer.h"
 
 using namespace test;
 using namespace toolimpl;
@@ -22,6 +24,12 @@ enum class CallType
     DONTFAILONUPWARDS,
     FAILEVERYTHING
 };
+ToolImpl::~ToolImpl()
+{
+    // Stop the persistent t8ntool server of this session if it was used
+    ToolServer::release(m_tmpDir);
+}
+
 #define TRYCATCHCALL(X, method, ctype)                                                                     \
     try {                                                                                                  \
         X                                                                                                  \
@@ -43,6 +51,37 @@ enum class CallType
     }                                                                                                      \
 
 
+namespace
+{
+// Validate the transactions with one t9n run per tool fork
+std::vector<TestRawTransaction> rawTransactionBatch(
+    std::vector<RawTransactionRequest> const& _requests, fs::path const& _toolPath, fs::path const& _tmpDir)
+{
+    std::map<string, std::vector<size_t>> forkRequests;
+    for (size_t i = 0; i < _requests.size(); i++)
+    {
+        auto const& genesisSetupInTool = Options::getCurrentConfig().getGenesisTemplate(_requests.at(i).fork);
+        forkRequests[genesisSetupInTool.getCContent().atKey("params").atKey("fork").asString()].push_back(i);
+    }
+
+    std::map<size_t, TestRawTransaction> results;
+    for (auto const& [t8nForkName, indexes] : forkRequests)
+    {
+        std::vector<spBYTES> rlps;
+        for (size_t i : indexes)
+            rlps.push_back(_requests.at(i).rlp);
+        auto const forkResults = ToolChainManager::test_rawTransactionBatch(rlps, FORK(t8nForkName), _toolPath, _tmpDir);
+        for (size_t i = 0; i < indexes.size(); i++)
+            results.emplace(indexes.at(i), forkResults.at(i));
+    }
+
+    std::vector<TestRawTransaction> res;
+    for (auto const& el : results)
+        res.push_back(el.second);
+    return res;
+}
+}  // namespace
+
 spDataObject ToolImpl::web3_clientVersion()
 {
     rpcCall("", {});
@@ -105,9 +144,9 @@ EthGetBlockBy ToolImpl::eth_getBlockByHash(FH32 const& _hash, Request _fullObjec
     (void)_fullObjects;
     ETH_TEST_MESSAGE("\nRequest: eth_getBlockByHash `" + _hash.asString());
     TRYCATCHCALL(
-        spDataObject res = constructEthGetBlockBy(blockchain().blockByHash(_hash));
-        ETH_LOG("Response: eth_getBlockByHash `" + res->asJson(), 7);
-        return EthGetBlockBy(res);
+        EthereumBlockState const& block = blockchain().blockByHash(_hash);
+        ETH_LOG("Response: eth_getBlockByHash `" + constructEthGetBlockBy(block)->asJson(), 7);
+        return EthGetBlockBy(block);
         , "eth_getBlockByHash", CallType::FAILEVERYTHING)
     spDataObject spnull(0);
     return EthGetBlockBy(spnull);
@@ -119,9 +158,9 @@ EthGetBlockBy ToolImpl::eth_getBlockByNumber(VALUE const& _blockNumber, Request
     (void)_fullObjects;
     ETH_TEST_MESSAGE("\nRequest: eth_getBlockByNumber `" + _blockNumber.asDecString());
     TRYCATCHCALL(
-        spDataObject res = constructEthGetBlockBy(blockchain().blockByNumber(_blockNumber));
-        ETH_LOG("Response: eth_getBlockByNumber `" + res->asJson(), 7);
-        return EthGetBlockBy(res);
+        EthereumBlockState const& block = blockchain().blockByNumber(_blockNumber);
+        ETH_LOG("Response: eth_getBlockByNumber `" + constructEthGetBlockBy(block)->asJson(), 7);
+        return EthGetBlockBy(block);
         , "eth_getBlockByNumber", CallType::FAILEVERYTHING)
     spDataObject spnull(0);
     return EthGetBlockBy(spnull);
@@ -161,10 +200,10 @@ DebugAccountRange ToolImpl::debug_accountRange(
     (void) _txIndex;
 
     TRYCATCHCALL(
-        spDataObject constructResponse =
-            constructAccountRange(blockchain().blockByNumber(_blockNumber), _addressHash, _maxResults);
-        ETH_TEST_MESSAGE("Response: debug_accountRange " + constructResponse->asJson());
-        return DebugAccountRange(constructResponse);
+        DebugAccountRange res = constructAccountRange(blockchain().blockByNumber(_blockNumber), _addressHash, _maxResults);
+        ETH_TEST_MESSAGE("Response: debug_accountRange, accounts: " + test::fto_string(res.addresses().size()) +
+                         ", nextKey: " + res.nextKey().asString());
+        return res;
         , "debug_accountRange", CallType::FAILEVERYTHING)
     return DebugAccountRange(DataObject());
 }
@@ -177,9 +216,10 @@ DebugAccountRange ToolImpl::debug_accountRange(
     (void) _txIndex;
 
     TRYCATCHCALL(
-        spDataObject constructResponse = constructAccountRange(blockchain().blockByHash(_blockHash), _addressHash, _maxResults);
-        ETH_TEST_MESSAGE("Response: debug_accountRange " + constructResponse->asJson());
-        return DebugAccountRange(constructResponse);
+        DebugAccountRange res = constructAccountRange(blockchain().blockByHash(_blockHash), _addressHash, _maxResults);
+        ETH_TEST_MESSAGE("Response: debug_accountRange, accounts: " + test::fto_string(res.addresses().size()) +
+                         ", nextKey: " + res.nextKey().asString());
+        return res;
         , "debug_accountRange", CallType::FAILEVERYTHING)
     return DebugAccountRange(DataObject());
 }
@@ -193,10 +233,9 @@ DebugStorageRangeAt ToolImpl::debug_storageRangeAt(
     (void) _txIndex;
 
     TRYCATCHCALL(
-        spDataObject constructResponse =
-            constructStorageRangeAt(blockchain().blockByNumber(_blockNumber), _address, _begin, _maxResults);
-        ETH_TEST_MESSAGE("Response: debug_storageRangeAt " + constructResponse->asJson());
-        return DebugStorageRangeAt(constructResponse);
+        DebugStorageRangeAt res = constructStorageRangeAt(blockchain().blockByNumber(_blockNumber), _address, _begin, _maxResults);
+        ETH_TEST_MESSAGE("Response: debug_storageRangeAt " + res.storage().asDataObject()->asJson());
+        return res;
         , "debug_storageRangeAt", CallType::FAILEVERYTHING)
     return DebugStorageRangeAt(DataObject());
 }
@@ -210,10 +249,9 @@ DebugStorageRangeAt ToolImpl::debug_storageRangeAt(
     (void) _txIndex;
 
     TRYCATCHCALL(
-        spDataObject constructResponse =
-            constructStorageRangeAt(blockchain().blockByHash(_blockHash), _address, _begin, _maxResults);
-        ETH_TEST_MESSAGE("Response: debug_storageRangeAt " + constructResponse->asJson());
-        return DebugStorageRangeAt(constructResponse);
+        DebugStorageRangeAt res = constructStorageRangeAt(blockchain().blockByHash(_blockHash), _address, _begin, _maxResults);
+        ETH_TEST_MESSAGE("Response: debug_storageRangeAt " + res.storage().asDataObject()->asJson());
+        return res;
         , "debug_storageRangeAt", CallType::FAILEVERYTHING)
     return DebugStorageRangeAt(DataObject());
 }
@@ -317,6 +355,16 @@ TestRawTransaction ToolImpl::test_rawTransaction(BYTES const& _rlp, FORK const&
     return TestRawTransaction(DataObject());
 }
 
+std::vector<TestRawTransaction> ToolImpl::test_rawTransactionBatch(std::vector<RawTransactionRequest> const& _requests)
+{
+    rpcCall("", {});
+    TRYCATCHCALL(
+        ETH_TEST_MESSAGE("\nRequest: test_rawTransactionBatch, transactions: " + test::fto_string(_requests.size()));
+        return rawTransactionBatch(_requests, m_toolPath, m_tmpDir);
+        , "test_rawTransactionBatch", CallType::FAILEVERYTHING)
+    return std::vector<TestRawTransaction>();
+}
+
 VALUE ToolImpl::test_calculateDifficulty(FORK const& _fork, VALUE const& _blockNumber, VALUE const& _parentTimestamp,
     VALUE const& _parentDifficulty, VALUE const& _currentTimestamp, VALUE const& _uncleNumber)
 {
@@ -331,6 +379,18 @@ VALUE ToolImpl::test_calculateDifficulty(FORK const& _fork, VALUE const& _blockN
     return VALUE(DataObject());
 }
 
+std::vector<spVALUE> ToolImpl::test_calculateDifficultyBatch(
+    FORK const& _fork, std::vector<DifficultyRequest> const& _requests)
+{
+    rpcCall("", {});
+    TRYCATCHCALL(
+        ETH_TEST_MESSAGE("\nRequest: test_calculateDifficultyBatch '" + _fork.asString() + "', vectors: " +
+                         test::fto_string(_requests.size()));
+        return ToolChainManager::test_calculateDifficultyBatch(_fork, _requests, m_toolPath, m_tmpDir);
+        , "test_calculateDifficultyBatch", CallType::FAILEVERYTHING)
+    return std::vector<spVALUE>();
+}
+
 // Internal
 spDataObject ToolImpl::rpcCall(
     std::string const& _methodName, std::vector<std::string> const& _args, bool _canFail)
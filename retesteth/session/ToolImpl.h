@@ -12,6 +12,7 @@ public:
     ToolImpl(Socket::SocketType _type, fs::path const& _path, fs::path const& _tmpDir)
       : m_sockType(_type), m_toolPath(_path), m_tmpDir(_tmpDir)
     {}
+    ~ToolImpl() override;
 
 public:
     spDataObject web3_clientVersion() override;
@@ -46,8 +47,11 @@ public:
     FH32 test_importRawBlock(BYTES const& _blockRLP) override;
     FH32 test_getLogHash(FH32 const& _txHash) override;
     TestRawTransaction test_rawTransaction(BYTES const& _rlp, FORK const& _fork) override;
+    std::vector<TestRawTransaction> test_rawTransactionBatch(std::vector<RawTransactionRequest> const& _requests) override;
     VALUE test_calculateDifficulty(FORK const& _fork, VALUE const& _blockNumber, VALUE const& _parentTimestamp,
         VALUE const& _parentDifficulty, VALUE const& _currentTimestamp, VALUE const& _uncleNumber) override;
+    std::vector<spVALUE> test_calculateDifficultyBatch(
+        FORK const& _fork, std::vector<DifficultyRequest> const& _requests) override;
 
     // Internal
     std::string sendRawRequest(std::string const& _request);
@@ -0,0 +1,34 @@
+#include <retesteth/session/ToolLibImpl.h>
+#include "ToolBackend/ToolLibrary.h"
+
+using namespace test;
+using namespace toolimpl;
+
+ToolLibImpl::ToolLibImpl(fs::path const& _libPath, fs::path const& _tmpDir)
+  : ToolImpl(Socket::SocketType::TCP, _libPath, _tmpDir), m_libPath(_libPath)
+{
+    // Load the library on session start, so the broken library fails before the tests
+    ToolLibrary::get(m_libPath);
+}
+
+spDataObject ToolLibImpl::web3_clientVersion()
+{
+    rpcCall("", {});
+    ETH_TEST_MESSAGE("\nRequest: web3_clientVersion");
+    spDataObject res(new DataObject(ToolLibrary::get(m_libPath).version()));
+    ETH_TEST_MESSAGE("Response: web3_clientVersion " + res->asString());
+    return res;
+}
+
+TestRawTransaction ToolLibImpl::test_rawTransaction(BYTES const&, FORK const&)
+{
+    // Library ABI has no t9n entry, transaction tests require socketType::transition-tool
+    ETH_FAIL_MESSAGE("test_rawTransaction is not supported by socketType::transition-library: " + m_libPath.string());
+    return TestRawTransaction(DataObject());
+}
+
+std::vector<TestRawTransaction> ToolLibImpl::test_rawTransactionBatch(std::vector<RawTransactionRequest> const&)
+{
+    ETH_FAIL_MESSAGE("test_rawTransaction is not supported by socketType::transition-library: " + m_libPath.string());
+    return std::vector<TestRawTransaction>();
+}
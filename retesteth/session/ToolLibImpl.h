@@ -0,0 +1,17 @@
+#pragma once
+#include <retesteth/session/ToolImpl.h>
+
+// Transition library backend. Same as ToolImpl, but transitions are executed in-process
+// by the shared library loaded with ToolLibrary instead of spawning t8ntool
+class ToolLibImpl : public ToolImpl
+{
+public:
+    ToolLibImpl(fs::path const& _libPath, fs::path const& _tmpDir);
+
+    spDataObject web3_clientVersion() override;
+    TestRawTransaction test_rawTransaction(BYTES const& _rlp, FORK const& _fork) override;
+    std::vector<TestRawTransaction> test_rawTransactionBatch(std::vector<RawTransactionRequest> const& _requests) override;
+
+private:
+    fs::path m_libPath;
+};
@@ -37,7 +37,9 @@ void ClientConfigFile::initWithData(DataObject const& _data)
             {"forks", {{DataType::Array}, jsonField::Required}},
             {"additionalForks", {{DataType::Array}, jsonField::Required}},
             {"exceptions", {{DataType::Object}, jsonField::Required}},
-            {"fieldReplace", {{DataType::Object}, jsonField::Optional}}});
+            {"fieldReplace", {{DataType::Object}, jsonField::Optional}},
+            {"toolServer", {{DataType::String}, jsonField::Optional}},
+            {"toolStdio", {{DataType::Bool}, jsonField::Optional}}});
 
     string const sErrorPath = "ClientConfig (" + m_configFilePath.string() + ") ";
     m_name = _data.atKey("name").asString();
@@ -52,9 +54,11 @@ void ClientConfigFile::initWithData(DataObject const& _data)
         m_socketType = ClientConfgSocketType::IPCDebug;
     else if (socketTypeStr == "tranition-tool")
         m_socketType = ClientConfgSocketType::TransitionTool;
+    else if (socketTypeStr == "transition-library")
+        m_socketType = ClientConfgSocketType::TransitionLibrary;
     else
         ETH_FAIL_MESSAGE(sErrorPath + "Unknown `socketType` : " + socketTypeStr +
-                         ", Allowed: ['ipc', 'tcp', 'ipc-debug', 'transition-tool']");
+                         ", Allowed: ['ipc', 'tcp', 'ipc-debug', 'transition-tool', 'transition-library']");
 
     // SocketAddress is an array of ipaddresses or path to a socket file
     if (m_socketType == ClientConfgSocketType::TCP)
@@ -106,7 +110,40 @@ void ClientConfigFile::initWithData(DataObject const& _data)
                 m_pathToExecFile.string() + ")");
         if (fs::exists(cfgPath / m_pathToExecFile))
             m_pathToExecFile = cfgPath / m_pathToExecFile;
+
+        // Transition tool could be kept alive as a server process instead of spawning it for each block
+        if (_data.count("toolServer"))
+        {
+            m_pathToToolServer = fs::path(_data.atKey("toolServer").asString());
+            ETH_FAIL_REQUIRE_MESSAGE(fs::exists(m_pathToToolServer) || fs::exists(cfgPath / m_pathToToolServer),
+                sErrorPath + "`toolServer` must point to a tool server cmd!" + " But file not found (" +
+                    m_pathToToolServer.string() + ")");
+            if (fs::exists(cfgPath / m_pathToToolServer))
+                m_pathToToolServer = cfgPath / m_pathToToolServer;
+        }
+
+        // Transition tool could read the input from stdin and print the result to stdout instead of files
+        m_toolStdio = false;
+        if (_data.count("toolStdio"))
+            m_toolStdio = _data.atKey("toolStdio").asBool();
     }
+    else if (m_socketType == ClientConfgSocketType::TransitionLibrary)
+    {
+        if (_data.atKey("socketAddress").type() != DataType::String)
+            ETH_FAIL_MESSAGE(sErrorPath + "`socketAddress` must be string for this socketType!");
+
+        // Shared library with t8n C ABI, transitions are executed inside retesteth process
+        m_pathToExecFile = fs::path(_data.atKey("socketAddress").asString());
+        fs::path const cfgPath = m_configFilePath.parent_path();
+        ETH_FAIL_REQUIRE_MESSAGE(fs::exists(m_pathToExecFile) || fs::exists(cfgPath / m_pathToExecFile),
+            sErrorPath + "`socketAddress` for socketType::transition-library must point to a shared library!" +
+                " But file not found (" + m_pathToExecFile.string() + ")");
+        if (fs::exists(cfgPath / m_pathToExecFile))
+            m_pathToExecFile = cfgPath / m_pathToExecFile;
+    }
+
+    if (m_socketType != ClientConfgSocketType::TransitionTool && (_data.count("toolServer") || _data.count("toolStdio")))
+        ETH_FAIL_MESSAGE(sErrorPath + "`toolServer`, `toolStdio` are only allowed for socketType::transition-tool!");
 
     m_initializeTime = 0;
     if (_data.count("initializeTime"))
@@ -17,7 +17,8 @@ enum class ClientConfgSocketType
     TCP,
     IPC,
     IPCDebug,
-    TransitionTool
+    TransitionTool,
+    TransitionLibrary
 };
 
 struct ClientConfigFile : GCP_SPointerBase
@@ -40,6 +41,8 @@ struct ClientConfigFile : GCP_SPointerBase
     std::map<string, string> const& fieldreplace() const { return m_fieldRaplce; }
     fs::path const& path() const { return m_configFilePath; }
     fs::path const& shell() const { return m_pathToExecFile; }
+    fs::path const& toolServer() const { return m_pathToToolServer; }
+    bool toolStdio() const { return m_toolStdio; }
 
 
 private:
@@ -52,6 +55,7 @@ private:
     std::vector<IPADDRESS> m_socketAddress;  ///< List of IP to connect to (IP::PORT)
     bool m_checkLogsHash;                    ///< Enable logsHash verification
     int m_chanID;                            ///< Use custom chainID
+    bool m_toolStdio = false;                ///< Transition tool io via stdin/stdout instead of files
 
     size_t m_initializeTime;                 ///< Time to start the instance
     std::vector<FORK> m_forks;               ///< Allowed forks as network name
@@ -62,6 +66,7 @@ private:
     // Additional values
     fs::path m_configFilePath;  ///< Path to the config file
     fs::path m_pathToExecFile;  ///< Path to cmd that runs the client instance (for t8ntool)
+    fs::path m_pathToToolServer;  ///< Path to cmd that runs persistent t8ntool server (optional)
 };
 
 
@@ -1,6 +1,7 @@
 #include "State.h"
 #include <retesteth/TestHelper.h>
 #include <retesteth/testStructures/Common.h>
+#include <mutex>
 
 namespace test
 {
@@ -41,6 +42,7 @@ State::Account::Account(spDataObject& _data)
 
 spDataObject const& State::Account::asDataObject() const
 {
+    std::lock_guard<std::mutex> lock(m_exportMutex);
     if (m_rawData->getSubObjects().size() == 0)
     {
         (*m_rawData).setKey(m_address->asString());
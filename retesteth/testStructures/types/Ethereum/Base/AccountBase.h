@@ -30,6 +30,7 @@ struct AccountBase : GCP_SPointerBase
     VALUE const& nonce() const { return m_nonce; }
     Storage const& storage() const { return m_storage; }
     BYTES const& code() const { return m_code; }
+    spBYTES const& codePtr() const { return m_code; }
     FH20 const& address() const { return m_address; }
 
     virtual spDataObject const& asDataObject() const = 0;
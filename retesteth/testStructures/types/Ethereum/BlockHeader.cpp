@@ -0,0 +1,43 @@
+#include "BlockHeader.h"
+#include <retesteth/EthChecks.h>
+#include <retesteth/testStructures/Common.h>
+
+namespace
+{
+// Values are compared as exported, so leading zeros of bigint values count
+template <class T>
+bool sameField(GCP_SPointer<T> const& _a, GCP_SPointer<T> const& _b)
+{
+    return _a->asString() == _b->asString();
+}
+}  // namespace
+
+namespace test
+{
+namespace teststruct
+{
+bool BlockHeader::equals(BlockHeader const& _rhs) const
+{
+    // Hash goes first as the most likely field to differ
+    return type() == _rhs.type() && sameField(m_hash, _rhs.m_hash) && sameField(m_stateRoot, _rhs.m_stateRoot) &&
+           sameField(m_number, _rhs.m_number) && sameField(m_parentHash, _rhs.m_parentHash) &&
+           sameField(m_difficulty, _rhs.m_difficulty) && sameField(m_author, _rhs.m_author) &&
+           sameField(m_extraData, _rhs.m_extraData) && sameField(m_gasUsed, _rhs.m_gasUsed) &&
+           sameField(m_gasLimit, _rhs.m_gasLimit) && sameField(m_logsBloom, _rhs.m_logsBloom) &&
+           sameField(m_mixHash, _rhs.m_mixHash) && sameField(m_nonce, _rhs.m_nonce) &&
+           sameField(m_receiptsRoot, _rhs.m_receiptsRoot) && sameField(m_sha3Uncles, _rhs.m_sha3Uncles) &&
+           sameField(m_timestamp, _rhs.m_timestamp) && sameField(m_transactionsRoot, _rhs.m_transactionsRoot);
+}
+
+string BlockHeader::diff(BlockHeader const& _rhs, string& _whatField) const
+{
+    if (type() != _rhs.type())
+    {
+        _whatField = "type";
+        return cYellow + "type " + cRed + TypeToString(type()) + " vs " + cYellow + TypeToString(_rhs.type()) + cRed + "\n";
+    }
+    return compareBlockHeaders(asDataObject().getCContent(), _rhs.asDataObject().getCContent(), _whatField);
+}
+
+}  // namespace teststruct
+}  // namespace test
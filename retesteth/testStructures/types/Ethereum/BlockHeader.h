@@ -39,7 +39,13 @@ struct BlockHeader : GCP_SPointerBase
     virtual dev::RLPStream const asRLPStream() const = 0;
     virtual BlockType type() const = 0;
 
-    bool operator==(BlockHeader const& _rhs) const { return asDataObject() == _rhs.asDataObject(); }
+    // Compare all fields of the headers of the same type
+    virtual bool equals(BlockHeader const& _rhs) const;
+
+    // Field by field comparison for the error message, _whatField is set to the first different field
+    string diff(BlockHeader const& _rhs, string& _whatField) const;
+
+    bool operator==(BlockHeader const& _rhs) const { return equals(_rhs); }
     bool operator!=(BlockHeader const& _rhs) const { return !(*this == _rhs); }
     static string BlockTypeToString(BlockType _bl)
     {
@@ -156,6 +156,14 @@ spDataObject BlockHeader1559::asDataObject() const
     return out;
 }
 
+bool BlockHeader1559::equals(BlockHeader const& _rhs) const
+{
+    // Same type means _rhs is BlockHeader1559 or BlockHeaderMerge
+    if (!BlockHeader::equals(_rhs))
+        return false;
+    return m_baseFee->asString() == dynamic_cast<BlockHeader1559 const&>(_rhs).baseFee().asString();
+}
+
 const RLPStream BlockHeader1559::asRLPStream() const
 {
     RLPStream header;
@@ -20,6 +20,7 @@ struct BlockHeader1559 : BlockHeader
     spDataObject asDataObject() const override;
     dev::RLPStream const asRLPStream() const override;
     BlockType type() const override { return BlockType::BlockHeader1559; }
+    bool equals(BlockHeader const& _rhs) const override;
 
     // Unique fields
     VALUE const& baseFee() const { return m_baseFee; }
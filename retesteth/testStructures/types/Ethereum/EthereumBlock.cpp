@@ -69,7 +69,7 @@ DebugVMTrace const& EthereumBlockState::getTrTrace(FH32 const& _hash) const
         return m_transactionsTrace.at(_hash);
     else
         ETH_ERROR_MESSAGE("Transaction trace not found! (" + _hash.asString() + ")");
-    static DebugVMTrace empty("", "", FH32::zero(), "");
+    static DebugVMTrace empty("", "", FH32::zero(), string());
     return empty;
 }
 
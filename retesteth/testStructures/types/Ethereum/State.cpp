@@ -10,12 +10,21 @@ State::State(std::map<FH20, spAccountBase>& _accList)
 {
     // We certain that account provided for the state is full and not incomplete
     m_accounts = _accList;
-    m_raw = spDataObject();
     for (auto const& el : _accList)
-    {
         ETH_ERROR_REQUIRE_MESSAGE(el.second->type() == AccountType::FullAccount, "State::State(std::map) provided account type is not of a FullAccount type!");
-        (*m_raw).atKeyPointer(el.first.asString()) = el.second->asDataObject();  // Recreate export data
-    }
+
+    // Export data is recreated on first use. States read from the tool are often never exported
+    m_raw.null();
+}
+
+State::State(State const& _other)
+{
+    // Copy the data only, the copy is a new object for the smart pointers
+    std::lock_guard<std::mutex> lock(_other.m_exportMutex);
+    m_accounts = _other.m_accounts;
+    m_raw = _other.m_raw;
+    m_jsonAlloc = _other.m_jsonAlloc;
+    m_jsonAllocCompact = _other.m_jsonAllocCompact;
 }
 
 State::State(spDataObjectMove _data)
@@ -53,12 +62,62 @@ bool State::hasAccount(FH20 const& _address) const
     return m_accounts.count(_address);
 }
 
+namespace
+{
+// Export tree made of account fields. Accounts are shared between block states,
+// so their own lazy export data is not touched
+spDataObject allocTree(std::map<FH20, spAccountBase> const& _accounts)
+{
+    spDataObject out(new DataObject(DataType::Object));
+    for (auto const& el : _accounts)
+    {
+        AccountBase const& acc = el.second.getCContent();
+        spDataObject account(new DataObject(DataType::Object));
+        (*account)["code"] = acc.code().asString();
+        (*account)["nonce"] = acc.nonce().asString();
+        (*account)["balance"] = acc.balance().asString();
+        (*account).atKeyPointer("storage") = acc.storage().asDataObject();
+        (*out).atKeyPointer(el.first.asString()) = account;
+    }
+    return out;
+}
+}  // namespace
+
 spDataObject const& State::asDataObject() const
 {
     // As long as we guarantee unmutability of parsed data in the structure
     // We can return the same data object as we got, not recalculating the whole thing
+    std::lock_guard<std::mutex> lock(m_exportMutex);
+    if (m_raw.isEmpty())
+    {
+        m_raw = spDataObject(new DataObject(DataType::Object));
+        for (auto const& el : m_accounts)
+            (*m_raw).atKeyPointer(el.first.asString()) = el.second->asDataObject();  // Recreate export data
+    }
     return m_raw;
 }
 
+string const& State::asJsonAlloc(bool _pretty) const
+{
+    // Same state is sent to the tool many times (rewind to genesis, tx variants of a test)
+    std::lock_guard<std::mutex> lock(m_exportMutex);
+    string& cache = _pretty ? m_jsonAlloc : m_jsonAllocCompact;
+    if (cache.empty())
+    {
+        // Do not keep the export tree of a state made of accounts, it is only needed for the json
+        if (!m_raw.isEmpty())
+            cache = m_raw->asJson(0, _pretty, true);
+        else
+            cache = allocTree(m_accounts)->asJson(0, _pretty, true);
+    }
+    return cache;
+}
+
+bool State::hasJsonAlloc(bool _pretty) const
+{
+    std::lock_guard<std::mutex> lock(m_exportMutex);
+    return !(_pretty ? m_jsonAlloc : m_jsonAllocCompact).empty();
+}
+
 }  // namespace teststruct
 }  // namespace test
@@ -2,6 +2,7 @@
 #include "Base/StateBase.h"
 #include <retesteth/dataObject/DataObject.h>
 #include <retesteth/dataObject/SPointer.h>
+#include <mutex>
 
 using namespace dataobject;
 using namespace test::teststruct;
@@ -23,6 +24,7 @@ public:
 public:
     State(spDataObjectMove);
     State(std::map<FH20, spAccountBase>&);
+    State(State const&);
 
     std::map<FH20, spAccountBase> const& accounts() const { return m_accounts; }
     Account const& getAccount(FH20 const& _address) const;
@@ -31,8 +33,17 @@ public:
 
     spDataObject const& asDataObject() const override;
 
+    // State json without the first key (t8ntool alloc), serialized once on first use
+    // Accounts are not changed after construction, so the serialized form never gets stale
+    // The lazy export data is filled under m_exportMutex, any thread could serialize the state
+    string const& asJsonAlloc(bool _pretty = true) const;
+    bool hasJsonAlloc(bool _pretty = true) const;
+
 private:
-    spDataObject m_raw;
+    mutable std::mutex m_exportMutex;
+    mutable spDataObject m_raw;
+    mutable string m_jsonAlloc;
+    mutable string m_jsonAllocCompact;
     State() {}
 
 public:
@@ -48,6 +59,9 @@ public:
 
     private:
         Account() {}
+
+        // Accounts are shared between block states, a chain and its alloc helper thread could export one at once
+        mutable std::mutex m_exportMutex;
     };
 
 };
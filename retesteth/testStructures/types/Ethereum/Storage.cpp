@@ -17,6 +17,12 @@ Storage::Storage(DataObject const& _data)
     }
 }
 
+Storage::Storage(std::map<string, StorageRecord>& _records)
+{
+    // Records are keyed by VALUE::asString of the record key
+    m_map.swap(_records);
+}
+
 void Storage::merge(Storage const& _storage)
 {
     // same keys???
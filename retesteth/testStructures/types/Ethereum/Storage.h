@@ -15,6 +15,7 @@ struct Storage : GCP_SPointerBase
 {
     Storage(DataObject const&);
     typedef std::tuple<spVALUE, spVALUE> StorageRecord;
+    Storage(std::map<string, StorageRecord>&);
 
     std::map<string, StorageRecord> const& getKeys() const { return m_map; }
     bool hasKey(VALUE const& _key) const { return m_map.count(_key.asString()); }
@@ -23,5 +23,9 @@ DebugAccountRange::DebugAccountRange(DataObject const& _data)
     }
 }
 
+DebugAccountRange::DebugAccountRange(std::vector<spFH20> const& _addresses, FH32 const& _nextKey)
+  : m_addresses(_addresses), m_nextKey(spFH32(_nextKey.copy()))
+{}
+
 }  // namespace teststruct
 }  // namespace test
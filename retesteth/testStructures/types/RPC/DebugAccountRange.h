@@ -12,6 +12,7 @@ namespace teststruct
 struct DebugAccountRange
 {
     DebugAccountRange(DataObject const&);
+    DebugAccountRange(std::vector<spFH20> const& _addresses, FH32 const& _nextKey);
     FH32 const& nextKey() const { return m_nextKey; }
     std::vector<spFH20> const& addresses() const { return m_addresses; }
 
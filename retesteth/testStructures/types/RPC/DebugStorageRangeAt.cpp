@@ -34,5 +34,9 @@ DebugStorageRangeAt::DebugStorageRangeAt(DataObject const& _data)
     }
 }
 
+DebugStorageRangeAt::DebugStorageRangeAt(spStorage const& _storage, FH32 const& _nextKey)
+  : m_storage(_storage), m_nextKey(spFH32(_nextKey.copy()))
+{}
+
 }  // namespace teststruct
 }  // namespace test
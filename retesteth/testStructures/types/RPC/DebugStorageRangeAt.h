@@ -13,6 +13,7 @@ namespace teststruct
 struct DebugStorageRangeAt
 {
     DebugStorageRangeAt(DataObject const&);
+    DebugStorageRangeAt(spStorage const& _storage, FH32 const& _nextKey);
     Storage const& storage() const { return m_storage; }
     FH32 const& nextKey() const { return m_nextKey; }
 
@@ -3,6 +3,10 @@
 #include <TestHelper.h>
 #include <dataObject/ConvertFile.h>
 #include <testStructures/Common.h>
+#include <Options.h>
+#include <algorithm>
+#include <fstream>
+#include <sstream>
 
 namespace test
 {
@@ -55,53 +59,93 @@ VMLogRecord::VMLogRecord(DataObject const& _obj)
 
 DebugVMTrace::DebugVMTrace(string const& _info, string const& _trNumber, FH32 const& _trHash, string const& _logs)
 {
-    try
-    {
-        m_infoString = _info;
-        m_trNumber = _trNumber;
-        m_trHash = spFH32(_trHash.copy());
+    m_infoString = _info;
+    m_trNumber = _trNumber;
+    m_trHash = spFH32(_trHash.copy());
+    m_rawUnparsedLogs = _logs;
+}
 
-        auto logs = test::explode(_logs, '\n');
-        if (logs.size())
-        {
-            for (size_t i = 0; i < logs.size() - 1; i++)
-                m_log.push_back(VMLogRecord(ConvertJsoncppStringToData(logs.at(i))));
+DebugVMTrace::DebugVMTrace(
+    string const& _info, string const& _trNumber, FH32 const& _trHash, boost::filesystem::path const& _logsPath)
+{
+    m_infoString = _info;
+    m_trNumber = _trNumber;
+    m_trHash = spFH32(_trHash.copy());
+    m_logsPath = _logsPath;
+}
 
-            spDataObject lastRecord = ConvertJsoncppStringToData(logs.at(logs.size() - 1));
-            m_output = lastRecord->atKey("output").asString();
-            m_gasUsed = spVALUE(new VALUE(lastRecord->atKey("gasUsed")));
-            m_time = lastRecord->atKey("time").asInt();
-        }
+void DebugVMTrace::readLogs(std::function<void(string const&)> const& _onLine) const
+{
+    if (m_logsPath.empty())
+    {
+        std::istringstream stream(m_rawUnparsedLogs);
+        readLogs(stream, _onLine);
+        return;
+    }
 
-        m_rawUnparsedLogs = _logs;
+    std::ifstream stream(m_logsPath.string());
+    if (!stream.is_open())
+    {
+        ETH_WARNING("Trace file `" + m_logsPath.string() + "` not found!");
+        return;
     }
-    catch (std::exception const& _ex)
+    readLogs(stream, _onLine);
+}
+
+void DebugVMTrace::readLogs(std::istream& _stream, std::function<void(string const&)> const& _onLine) const
+{
+    size_t const maxSize = Options::get().vmtraceMaxSizeMB * 1024 * 1024;
+    size_t readSize = 0;
+    string line;
+    while (std::getline(_stream, line))
     {
-        throw UpwardsException(string("DebugVMTrace parse error: ") + _ex.what());
+        readSize += line.size() + 1;
+        if (maxSize && readSize > maxSize)
+        {
+            ETH_LOG("VMTrace is cut at " + test::fto_string(Options::get().vmtraceMaxSizeMB) +
+                        " MB (--vmtrace.maxsize)", 0);
+            return;
+        }
+        if (!line.empty())
+            _onLine(line);
     }
 }
 
 void DebugVMTrace::print()
 {
     ETH_LOG(m_infoString, 0);
-    ETH_LOG(m_rawUnparsedLogs, 0);
+    try
+    {
+        readLogs([](string const& _line) { ETH_LOG(_line, 0); });
+    }
+    catch (std::exception const& _ex)
+    {
+        throw UpwardsException(string("DebugVMTrace parse error: ") + _ex.what());
+    }
 }
 
 void DebugVMTrace::printNice()
 {
     ETH_LOG(m_infoString, 0);
-    if (m_log.size() == 0)
-        return;
 
     string s_comment = "";
-    dev::bigint maxGas = m_log.at(0).gas->asBigInt();
+    dev::bigint maxGas = -1;
     size_t k = 0;
     size_t const step = 9;
     string const stepw = "          ";
-    std::cout << test::cBYellowBlack << "N" << setw(15) << "OPNAME" << setw(10) << "GASCOST" << setw(10) << "TOTALGAS"
-              << setw(10) << "REMAINGAS" << setw(20) << "ERROR" << test::cDefault << std::endl;
-    for (VMLogRecord const& el : m_log)
-    {
+    auto printRecord = [&](string const& _line) {
+        spDataObject record = ConvertJsoncppStringToData(_line);
+        if (!record->count("pc"))
+            return;  // Last record is the transaction summary
+
+        VMLogRecord const el(record);
+        if (maxGas == -1)
+        {
+            maxGas = el.gas->asBigInt();
+            std::cout << test::cBYellowBlack << "N" << setw(15) << "OPNAME" << setw(10) << "GASCOST" << setw(10)
+                      << "TOTALGAS" << setw(10) << "REMAINGAS" << setw(20) << "ERROR" << test::cDefault << std::endl;
+        }
+
         if (!s_comment.empty())
         {
             std::cout << setw(step * el.depth) << test::cYellow << s_comment << test::cDefault << std::endl;
@@ -125,7 +169,69 @@ void DebugVMTrace::printNice()
             s_comment = stepw + "MSTORE [" + el.stack.at(el.stack.size() - 1) + "] = " + el.stack.at(el.stack.size() - 2);
         if (el.opName == "RETURN")
             s_comment = stepw + "RETURN " + el.memory->asString();
+    };
+
+    try
+    {
+        readLogs(printRecord);
     }
+    catch (std::exception const& _ex)
+    {
+        throw UpwardsException(string("DebugVMTrace parse error: ") + _ex.what());
+    }
+    if (maxGas != -1)
+        std::cout << std::endl;
+}
+
+void DebugVMTrace::printSummary()
+{
+    ETH_LOG(m_infoString, 0);
+
+    size_t steps = 0;
+    size_t maxDepth = 0;
+    std::map<string, size_t> opCount;
+    std::vector<string> errors;
+    spDataObject lastRecord;
+    auto countRecord = [&](string const& _line) {
+        spDataObject record = ConvertJsoncppStringToData(_line);
+        if (!record->count("pc"))
+        {
+            lastRecord = record;
+            return;
+        }
+        VMLogRecord const el(record);
+        steps++;
+        maxDepth = max(maxDepth, el.depth);
+        opCount[el.opName]++;
+        if (!el.error.empty())
+            errors.push_back(test::fto_string(steps - 1) + " " + el.opName + ": " + el.error);
+    };
+
+    try
+    {
+        readLogs(countRecord);
+    }
+    catch (std::exception const& _ex)
+    {
+        throw UpwardsException(string("DebugVMTrace parse error: ") + _ex.what());
+    }
+
+    std::cout << "Steps: " << steps << ", max depth: " << maxDepth;
+    if (lastRecord->count("gasUsed"))
+        std::cout << ", gasUsed: " << VALUE(lastRecord->atKey("gasUsed")).asDecString();
+    if (lastRecord->count("output"))
+        std::cout << ", output: " << lastRecord->atKey("output").asString();
+    std::cout << std::endl;
+
+    // Most executed opcodes first
+    std::vector<std::pair<string, size_t>> ops(opCount.begin(), opCount.end());
+    std::sort(ops.begin(), ops.end(), [](std::pair<string, size_t> const& _a, std::pair<string, size_t> const& _b) {
+        return _a.second > _b.second;
+    });
+    for (auto const& op : ops)
+        std::cout << setw(15) << op.first << setw(10) << op.second << std::endl;
+    for (auto const& error : errors)
+        std::cout << test::cYellow << "Error at step " << error << test::cDefault << std::endl;
     std::cout << std::endl;
 }
 
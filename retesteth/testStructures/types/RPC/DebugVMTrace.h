@@ -1,6 +1,9 @@
 #pragma once
 #include "../../basetypes.h"
 #include <retesteth/dataObject/DataObject.h>
+#include <boost/filesystem/path.hpp>
+#include <functional>
+#include <istream>
 
 using namespace dataobject;
 
@@ -32,24 +35,28 @@ struct VMLogRecord
     string error;
 };
 
+// Logs are not parsed until printed. Traces of loop heavy tests are hundreds of MB
 struct DebugVMTrace
 {
     DebugVMTrace() {}  // for tuples
     DebugVMTrace(string const& _info, string const& _trNumber, FH32 const& _trHash, string const& _logs);
+
+    // Trace file of the tool is streamed when printed, it is not loaded into memory
+    DebugVMTrace(string const& _info, string const& _trNumber, FH32 const& _trHash, boost::filesystem::path const& _logsPath);
     void print();
     void printNice();
+    void printSummary();
 
 private:
+    // Call _onLine for every log line up to --vmtrace.maxsize
+    void readLogs(std::function<void(string const&)> const& _onLine) const;
+    void readLogs(std::istream& _stream, std::function<void(string const&)> const& _onLine) const;
+
     string m_infoString;
     string m_trNumber;
     spFH32 m_trHash;
-    std::vector<VMLogRecord> m_log;
     string m_rawUnparsedLogs;
-
-    // Last record
-    string m_output;
-    spVALUE m_gasUsed;
-    long long m_time;
+    boost::filesystem::path m_logsPath;
 };
 
 
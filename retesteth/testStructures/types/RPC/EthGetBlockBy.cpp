@@ -68,6 +68,17 @@ EthGetBlockBy::EthGetBlockBy(spDataObject& _data)
     }
 }
 
+EthGetBlockBy::EthGetBlockBy(EthereumBlockState const& _block)
+{
+    m_header = _block.header();
+    m_size = spVALUE(new VALUE(0));
+    m_totalDifficulty = spVALUE(new VALUE(0));
+    for (auto const& tr : _block.transactions())
+        m_transactions.push_back(EthGetBlockByTransaction(tr, m_header->hash(), m_header->number()));
+    for (auto const& un : _block.uncles())
+        m_uncles.push_back(un->hash());
+}
+
 bool EthGetBlockBy::hasTransaction(FH32 const& _hash) const
 {
     for (auto const& tr : m_transactions)
@@ -10,10 +10,15 @@ namespace test
 {
 namespace teststruct
 {
+struct EthereumBlockState;
+
 // Structure for RPC response eth_getBlockByHash/eth_getBlockByNumber
 struct EthGetBlockBy : GCP_SPointerBase
 {
     EthGetBlockBy(spDataObject&);
+
+    // Block of the tool backend chain. Header and transactions are shared with the block, do not modify them
+    EthGetBlockBy(EthereumBlockState const& _block);
     spBlockHeader const& header() const { return m_header; }
     std::vector<EthGetBlockByTransaction> const& transactions() const { return m_transactions; }
     std::vector<FH32> const& uncles() const { return m_uncles; }
@@ -35,5 +35,17 @@ EthGetBlockByTransaction::EthGetBlockByTransaction(spDataObjectMove _data)
     }
 }
 
+EthGetBlockByTransaction::EthGetBlockByTransaction(
+    spTransaction const& _tr, FH32 const& _blockHash, VALUE const& _blockNumber)
+  : m_transaction(_tr)
+{
+    // Sender and index are not known to the tool backend
+    m_blockHash = spFH32(_blockHash.copy());
+    m_blockNumber = spVALUE(_blockNumber.copy());
+    m_from = spFH20(FH20::zero().copy());
+    m_hash = spFH32(_tr->hash().copy());
+    m_transactionIndex = spVALUE(new VALUE(0));
+}
+
 }  // namespace teststruct
 }  // namespace test
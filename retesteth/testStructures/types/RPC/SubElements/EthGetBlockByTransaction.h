@@ -13,6 +13,7 @@ namespace teststruct
 struct EthGetBlockByTransaction
 {
     EthGetBlockByTransaction(spDataObjectMove);
+    EthGetBlockByTransaction(spTransaction const& _tr, FH32 const& _blockHash, VALUE const& _blockNumber);
     FH32 const& hash() const { return m_hash; }
     spTransaction const& transaction() const
     {
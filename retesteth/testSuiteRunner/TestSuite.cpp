@@ -29,6 +29,7 @@
 #include <retesteth/session/Session.h>
 #include <retesteth/session/ThreadManager.h>
 #include <retesteth/testSuiteRunner/TestSuite.h>
+#include <retesteth/testSuiteRunner/TestTimings.h>
 #include <retesteth/testSuites/TestFixtures.h>
 #include <boost/test/unit_test.hpp>
 #include <string>
@@ -183,9 +184,18 @@ void TestSuite::runAllTestsInFolder(string const& _testFolder) const
 
         if (RPCSession::isRunningTooLong() || TestChecker::isTimeConsumingTest(_testFolder.c_str()))
             RPCSession::restartScripts(true);
-
-        testOutput.initTest(testFillers.size());
-        for (auto const& testFillerPath : testFillers)
+        if (!testFillers.empty() && !ExitHandler::receivedExitSignal())
+            RPCSession::warmUp(std::min(testFillers.size(), ThreadManager::maxAllowedThreads()));
+
+        // Run the fillers that took longest on the previous runs first
+        std::vector<fs::path> fillers = testFillers;
+        double predictedMakespan = 0;
+        if (TestTimings::enabled())
+            predictedMakespan = TestTimings::schedule(_testFolder, fillers, Options::get().threadCount);
+        dev::Timer folderTimer;
+
+        testOutput.initTest(fillers.size());
+        for (auto const& testFillerPath : fillers)
         {
             if (ExitHandler::receivedExitSignal())
                 break;
@@ -199,10 +209,17 @@ void TestSuite::runAllTestsInFolder(string const& _testFolder) const
             if (ExitHandler::receivedExitSignal())
                 break;
 
-            auto job = [this, &_testFolder, &testFillerPath]() { executeTest(_testFolder, testFillerPath); };
+            auto job = [this, &_testFolder, &testFillerPath]() {
+                dev::Timer timer;
+                executeTest(_testFolder, testFillerPath);
+                if (TestTimings::enabled() && !ExitHandler::receivedExitSignal())
+                    TestTimings::record(_testFolder, testFillerPath, timer.elapsed());
+            };
             ThreadManager::addTask(job);
         }
         ThreadManager::joinThreads();
+        if (TestTimings::enabled() && !ExitHandler::receivedExitSignal())
+            TestTimings::report(_testFolder, predictedMakespan, folderTimer.elapsed());
         testOutput.finishTest();
     };
     runFunctionForAllClients(thisPart);
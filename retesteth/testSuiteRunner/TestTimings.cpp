@@ -0,0 +1,168 @@
+#include "TestTimings.h"
+#include <libdevcore/CommonIO.h>
+#include <retesteth/EthChecks.h>
+#include <retesteth/Options.h>
+#include <retesteth/TestHelper.h>
+#include <algorithm>
+#include <functional>
+#include <iomanip>
+#include <map>
+#include <mutex>
+#include <queue>
+#include <sstream>
+
+using namespace std;
+using namespace test;
+
+namespace
+{
+typedef std::map<string, double> FillerTimes;  // "<folder>/<filler>" => seconds
+
+std::mutex g_timingsMutex;
+std::map<string, FillerTimes> g_timings;  // "<client>/<mode>" => times
+bool g_timingsLoaded = false;
+
+string timingsSection()
+{
+    ClientConfig const& cfg = Options::getDynamicOptions().getCurrentConfig();
+    return cfg.cfgFile().name() + "/" + (Options::get().filltests ? "fill" : "run");
+}
+
+string secondsString(double _seconds)
+{
+    std::ostringstream out;
+    out << std::fixed << std::setprecision(1) << _seconds << "s";
+    return out.str();
+}
+
+string fillerKey(string const& _folder, fs::path const& _filler)
+{
+    return _folder + "/" + _filler.filename().string();
+}
+
+// Read the times of the previous runs. Called under the mutex
+void loadTimings()
+{
+    g_timingsLoaded = true;
+    fs::path const& file = Options::get().timingsFile.get();
+    if (!fs::exists(file))
+        return;
+
+    try
+    {
+        spDataObject const data = test::readJsonData(file);
+        for (auto const& client : data->getSubObjects())
+            for (auto const& mode : client->getSubObjects())
+            {
+                FillerTimes& times = g_timings[client->getKey() + "/" + mode->getKey()];
+                for (auto const& filler : mode->getSubObjects())
+                    times[filler->getKey()] = filler->asInt() / 1000.0;
+            }
+    }
+    catch (std::exception const& _ex)
+    {
+        ETH_WARNING("TestTimings failed to read `" + file.string() + "`: " + _ex.what());
+    }
+}
+
+// Write all times to the file. Called under the mutex
+void saveTimings()
+{
+    spDataObject data(new DataObject(DataType::Object));
+    for (auto const& section : g_timings)
+    {
+        size_t const pos = section.first.rfind('/');
+        DataObject& mode = (*data)[section.first.substr(0, pos)][section.first.substr(pos + 1)];
+        for (auto const& filler : section.second)
+            mode[filler.first] = (int)(filler.second * 1000);
+    }
+    writeFile(Options::get().timingsFile.get(), dev::asBytes(data->asJson()));
+}
+}  // namespace
+
+namespace test
+{
+bool TestTimings::enabled()
+{
+    return Options::get().timingsFile.is_initialized();
+}
+
+double TestTimings::makespan(std::vector<double> const& _times, size_t _workers)
+{
+    // Every next job goes to the least loaded worker
+    std::priority_queue<double, std::vector<double>, std::greater<double>> loads;
+    for (size_t i = 0; i < std::max<size_t>(_workers, 1); i++)
+        loads.push(0);
+    double result = 0;
+    for (double const time : _times)
+    {
+        double const load = loads.top() + time;
+        loads.pop();
+        loads.push(load);
+        result = std::max(result, load);
+    }
+    return result;
+}
+
+double TestTimings::schedule(string const& _folder, std::vector<fs::path>& _fillers, size_t _workers)
+{
+    std::vector<double> expected;
+    {
+        std::lock_guard<std::mutex> lock(g_timingsMutex);
+        if (!g_timingsLoaded)
+            loadTimings();
+        FillerTimes const& times = g_timings[timingsSection()];
+
+        double known = 0;
+        size_t knownCount = 0;
+        for (auto const& filler : _fillers)
+        {
+            auto const it = times.find(fillerKey(_folder, filler));
+            expected.push_back(it == times.end() ? -1 : it->second);
+            if (it != times.end())
+            {
+                known += it->second;
+                knownCount++;
+            }
+        }
+
+        double const average = knownCount ? known / knownCount : 0;
+        for (auto& time : expected)
+            if (time < 0)
+                time = average;
+        ETH_LOG("TestTimings: " + _folder + " has " + fto_string(knownCount) + " of " + fto_string(_fillers.size()) +
+                    " fillers with known time",
+            6);
+    }
+
+    // Longest first, keep the directory order for equal times
+    std::vector<size_t> order(_fillers.size());
+    for (size_t i = 0; i < order.size(); i++)
+        order.at(i) = i;
+    std::stable_sort(order.begin(), order.end(), [&expected](size_t _a, size_t _b) { return expected.at(_a) > expected.at(_b); });
+
+    std::vector<fs::path> sorted;
+    std::vector<double> sortedTimes;
+    for (size_t const i : order)
+    {
+        sorted.push_back(_fillers.at(i));
+        sortedTimes.push_back(expected.at(i));
+    }
+    _fillers.swap(sorted);
+    return makespan(sortedTimes, _workers);
+}
+
+void TestTimings::record(string const& _folder, fs::path const& _filler, double _seconds)
+{
+    std::lock_guard<std::mutex> lock(g_timingsMutex);
+    g_timings[timingsSection()][fillerKey(_folder, _filler)] = _seconds;
+}
+
+void TestTimings::report(string const& _folder, double _predicted, double _actual)
+{
+    std::lock_guard<std::mutex> lock(g_timingsMutex);
+    ETH_STDOUT_MESSAGE(_folder + " makespan predicted: " + secondsString(_predicted) + ", actual: " + secondsString(_actual));
+    saveTimings();
+}
+
+}  // namespace test
@@ -0,0 +1,32 @@
+#pragma once
+#include <boost/filesystem.hpp>
+#include <string>
+#include <vector>
+namespace fs = boost::filesystem;
+
+namespace test
+{
+// Execution times of test fillers from the previous runs, enabled with `--timings <file>`
+// Times are kept per client config and mode: {"<client>" : {"fill" : {"<folder>/<filler>" : ms}, "run" : {..}}}
+// The fillers of a folder are queued longest expected time first (LPT), so that a heavy filler
+// does not start last and define the run time of the folder. A filler without a record is expected
+// to take the average time of the known fillers of the folder
+class TestTimings
+{
+public:
+    static bool enabled();
+
+    // Order _fillers longest expected time first. Return the predicted makespan on _workers threads
+    static double schedule(std::string const& _folder, std::vector<fs::path>& _fillers, size_t _workers);
+
+    // Remember the execution time of a filler
+    static void record(std::string const& _folder, fs::path const& _filler, double _seconds);
+
+    // Print the predicted and the actual makespan of the folder and save the times
+    static void report(std::string const& _folder, double _predicted, double _actual);
+
+    // Makespan of greedy scheduling of _times (in that order) on _workers threads
+    static double makespan(std::vector<double> const& _times, size_t _workers);
+};
+
+}  // namespace test
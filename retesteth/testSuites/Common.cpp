@@ -64,6 +64,8 @@ void printVmTrace(SessionInterface& _session, FH32 const& _trHash, FH32 const& _
     ETH_STDOUT_MESSAGE("------------------------");
     if (Options::get().vmtraceraw)
         ret.print();
+    else if (Options::get().vmtracesummary)
+        ret.printSummary();
     else
         ret.printNice();
 
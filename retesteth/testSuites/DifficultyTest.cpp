@@ -16,18 +16,15 @@ namespace fs = boost::filesystem;
 namespace
 {
 
-spDataObject makeTest(FORK const& _fork, VALUE const& _bn, VALUE const& _td, VALUE const& _pd, VALUE const& _un)
+spDataObject makeTest(DifficultyRequest const& _req, VALUE const& _res)
 {
     spDataObject test;
-    SessionInterface& session = RPCSession::instance(TestOutputHelper::getThreadID());
-
-    VALUE const res = session.test_calculateDifficulty(_fork, _bn, 0, _pd, _td, _un);
     (*test)["parentTimestamp"] = "0x00";
-    (*test)["parentUncles"] = _un.asString();
-    (*test)["parentDifficulty"] = _pd.asString();
-    (*test)["currentTimestamp"] = _td.asString();
-    (*test)["currentBlockNumber"] = _bn.asString();
-    (*test)["currentDifficulty"] = res.asString();
+    (*test)["parentUncles"] = _req.uncleNumber->asString();
+    (*test)["parentDifficulty"] = _req.parentDifficulty->asString();
+    (*test)["currentTimestamp"] = _req.currentTimestamp->asString();
+    (*test)["currentBlockNumber"] = _req.blockNumber->asString();
+    (*test)["currentDifficulty"] = _res.asString();
     return test;
 }
 
@@ -55,22 +52,23 @@ spDataObject FillTest(DifficultyTestInFiller const& _test)
         if (networkSkip)
             continue;
 
-        spDataObject filledTestNetwork;
+        // All vectors of the fork are calculated in one batch
+        std::vector<DifficultyRequest> requests;
         for (auto const& bn : _test.blocknumbers().vector())
-        {
             for (auto const& td : _test.timestumps().vector())
-            {
                 for (auto const& pd : _test.parentdiffs().vector())
-                {
                     for (auto const& un : _test.uncles())
-                    {
-                        if (ExitHandler::receivedExitSignal())
-                            break;
-                        string const testname = _test.testName() + "-" + test::fto_string(i++);
-                        (*filledTestNetwork).atKeyPointer(testname) = makeTest(fork, bn, td, pd, un);
-                    }
-                }
-            }
+                        requests.push_back({bn, spVALUE(new VALUE(0)), pd, td, spVALUE(new VALUE(un))});
+
+        SessionInterface& session = RPCSession::instance(TestOutputHelper::getThreadID());
+        std::vector<spVALUE> const results = session.test_calculateDifficultyBatch(fork, requests);
+        ETH_ERROR_REQUIRE_MESSAGE(results.size() == requests.size(), "test_calculateDifficultyBatch returned wrong number of results");
+
+        spDataObject filledTestNetwork;
+        for (size_t j = 0; j < requests.size(); j++)
+        {
+            string const testname = _test.testName() + "-" + test::fto_string(i++);
+            (*filledTestNetwork).atKeyPointer(testname) = makeTest(requests.at(j), results.at(j));
         }
 
         (*filledTest).atKeyPointer(fork.asString()) = filledTestNetwork;
@@ -83,6 +81,8 @@ void RunTest(DifficultyTestInFilled const& _test)
     TestOutputHelper::get().setCurrentTestName(_test.testName());
     SessionInterface& session = RPCSession::instance(TestOutputHelper::getThreadID());
 
+    // Every vector is checked on the client. The batch call is for filling only,
+    // on a tool it calculates the vectors with retesteth formula and checks a sample on the tool
     for (auto const& v : _test.testVectors())
     {
         for (auto const& el : v.second)
@@ -23,6 +23,9 @@
 
 #include <boost/filesystem/operations.hpp>
 #include <boost/test/unit_test.hpp>
+#include <functional>
+#include <limits>
+#include <map>
 #include <thread>
 #include <mutex>
 
@@ -34,6 +37,7 @@
 #include <retesteth/TestHelper.h>
 #include <retesteth/TestOutputHelper.h>
 #include <retesteth/session/Session.h>
+#include <retesteth/session/ThreadManager.h>
 #include <retesteth/testStructures/Common.h>
 #include <retesteth/testStructures/PrepareChainParams.h>
 #include <retesteth/testStructures/structures.h>
@@ -92,6 +96,159 @@ void checkUnexecutedTransactions(std::vector<TransactionInGeneralSection> const&
     ETH_ERROR_REQUIRE_MESSAGE(atLeastOneExecuted, "Specified filter did not run a single transaction! ");
 }
 
+/// Recover transaction labels from filled test _info section
+void assignTransactionLabels(StateTestInFilled const& _test, std::vector<TransactionInGeneralSection>& _txs)
+{
+    for (auto const& _infoLabels : _test.testInfo().labels())
+    {
+        // find a transaction with such index
+        // might make sense having el.dataIndString()
+        auto res = std::find_if(_txs.begin(), _txs.end(),
+            [&_infoLabels](TransactionInGeneralSection const& el) { return el.dataIndS() == _infoLabels.first; });
+        if (res != _txs.end())
+            (*res).assignTransactionLabel(":label " + _infoLabels.second);
+        else
+            ETH_WARNING("Test `_info` section has a label with tr.index that was not found!");
+    }
+}
+
+/// A part of the test that could be executed on any worker: transactions [txBegin, txEnd) on a fork
+struct TestCell
+{
+    size_t fork;
+    size_t txBegin;
+    size_t txEnd;
+};
+
+/// Split the forks of a test into cells. With -j the transactions of a fork are split as well,
+/// so that a big test is shared by the idle workers and does not run on one thread only
+std::vector<TestCell> makeTestCells(size_t _forkCount, size_t _txCount)
+{
+    size_t const cellsPerWorker = 4;
+    size_t const threads = Options::get().threadCount;
+    size_t chunks = 1;
+    if (threads > 1 && _forkCount > 0 && _forkCount < threads * cellsPerWorker)
+        chunks = std::max<size_t>(1, std::min(_txCount, (threads * cellsPerWorker + _forkCount - 1) / _forkCount));
+    size_t const chunkSize = std::max<size_t>(1, (_txCount + chunks - 1) / chunks);
+
+    std::vector<TestCell> cells;
+    for (size_t fork = 0; fork < _forkCount; fork++)
+    {
+        if (_txCount == 0)
+            cells.push_back({fork, 0, 0});
+        for (size_t begin = 0; begin < _txCount; begin += chunkSize)
+            cells.push_back({fork, begin, std::min(begin + chunkSize, _txCount)});
+    }
+    return cells;
+}
+
+/// Run the cells of a test, cells go to idle workers if -j allows
+/// A cell works on a copy of transactions taken for the time of its execution,
+/// executed/skipped marks are merged back into _txs
+/// The last argument of _cellJob is true if the previous cell on this thread had the same fork
+/// and finished, so the session already has the chain params of the fork (rewound to genesis)
+void runCellJobs(std::vector<TestCell> const& _cells, std::vector<TransactionInGeneralSection>& _txs,
+    std::function<std::vector<TransactionInGeneralSection>()> const& _buildTxs,
+    std::function<void(size_t, std::vector<TransactionInGeneralSection>&, bool)> const& _cellJob)
+{
+    size_t const c_noFork = std::numeric_limits<size_t>::max();
+
+    // Unit tests expect exceptions in this thread's output helper
+    if (Options::get().threadCount <= 1 || _cells.size() <= 1 || TestOutputHelper::get().getUnitTestExceptions().size() > 0)
+    {
+        size_t lastFork = c_noFork;
+        for (size_t i = 0; i < _cells.size(); i++)
+        {
+            if (ExitHandler::receivedExitSignal())
+                return;
+            _cellJob(i, _txs, _cells.at(i).fork == lastFork);
+            lastFork = _cells.at(i).fork;
+        }
+        return;
+    }
+
+    // Transactions carry lazy caches. No more copies than cells that could run at the same time
+    // The copies are built here, buildTransactions is not called from several threads
+    size_t const copies = std::min(_cells.size(), Options::get().threadCount);
+    std::vector<std::vector<TransactionInGeneralSection>> cellTxs;
+    for (size_t i = 0; i < copies; i++)
+        cellTxs.push_back(_buildTxs());
+    std::mutex freeTxsMutex;
+    std::vector<std::vector<TransactionInGeneralSection>*> freeTxs;
+    for (auto& txs : cellTxs)
+        freeTxs.push_back(&txs);
+
+    // A thread that joined the group takes its cells one after another (cells are ordered by fork)
+    // Keep the fork of the chain params set on the session of each thread, so that they are set once per fork
+    std::map<std::thread::id, size_t> threadFork;
+
+    std::thread::id const parentThread = TestOutputHelper::getThreadID();
+    fs::path const testFile = TestOutputHelper::get().testFile();
+    string const testName = TestOutputHelper::get().testName();
+
+    std::vector<std::function<void()>> jobs;
+    for (size_t i = 0; i < _cells.size(); i++)
+    {
+        jobs.push_back([&, i]() {
+            if (ExitHandler::receivedExitSignal())
+                return;
+            if (TestOutputHelper::getThreadID() != parentThread)
+            {
+                TestOutputHelper::get().setCurrentTestFile(testFile);
+                TestOutputHelper::get().setCurrentTestName(testName);
+                RPCSession::sessionStart(TestOutputHelper::getThreadID());
+            }
+
+            std::thread::id const threadID = TestOutputHelper::getThreadID();
+            std::vector<TransactionInGeneralSection>* txs = nullptr;
+            bool sameFork = false;
+            {
+                std::lock_guard<std::mutex> lock(freeTxsMutex);
+                ETH_FAIL_REQUIRE_MESSAGE(freeTxs.size() > 0, "runCellJobs: more cells running than transaction copies!");
+                txs = freeTxs.back();
+                freeTxs.pop_back();
+                auto const it = threadFork.find(threadID);
+                sameFork = it != threadFork.end() && it->second == _cells.at(i).fork;
+            }
+            try
+            {
+                _cellJob(i, *txs, sameFork);
+            }
+            catch (...)
+            {
+                std::lock_guard<std::mutex> lock(freeTxsMutex);
+                freeTxs.push_back(txs);
+                threadFork.erase(threadID);
+                throw;
+            }
+            std::lock_guard<std::mutex> lock(freeTxsMutex);
+            freeTxs.push_back(txs);
+            threadFork[threadID] = _cells.at(i).fork;
+        });
+    }
+
+    auto mergeMarks = [&_txs, &cellTxs]() {
+        for (auto const& txs : cellTxs)
+            for (size_t k = 0; k < txs.size() && k < _txs.size(); k++)
+            {
+                if (txs.at(k).getExecuted())
+                    _txs.at(k).markExecuted();
+                if (txs.at(k).getSkipped())
+                    _txs.at(k).markSkipped();
+            }
+    };
+
+    try
+    {
+        ThreadManager::runSubTasks(jobs);
+    }
+    catch (...)
+    {
+        mergeMarks();
+        throw;
+    }
+    mergeMarks();
+}
 
 /// Generate a blockchain test from state test filler
 spDataObject FillTestAsBlockchain(StateTestInFiller const& _test)
@@ -215,14 +372,131 @@ spDataObject FillTestAsBlockchain(StateTestInFiller const& _test)
     return filledTest;
 }
 
+/// Filled post results of a cell, keyed by (expect section index, transaction index)
+struct FillCellResults
+{
+    std::map<std::pair<size_t, size_t>, spDataObject> results;
+    std::vector<char> expectFound;  // expect section covers a transaction of the cell
+};
+
+/// Fill the post results of a single cell
+FillCellResults FillTestCell(StateTestInFiller const& _test, FORK const& _fork, TestCell const& _cell,
+    std::vector<TransactionInGeneralSection>& _txs, bool _chainParamsSet)
+{
+    SessionInterface& session = RPCSession::instance(TestOutputHelper::getThreadID());
+
+    // Skip by --singlenet option
+    bool networkSkip = false;
+    Options const& opt = Options::get();
+
+    if ((!opt.singleTestNet.empty() && FORK(opt.singleTestNet) != _fork) ||
+        !Options::getDynamicOptions().getCurrentConfig().checkForkAllowed(_fork))
+        networkSkip = true;
+
+    FillCellResults cellResults;
+    cellResults.expectFound.resize(_test.Expects().size(), false);
+
+    if (!networkSkip && !_chainParamsSet)
+    {
+        auto const p = prepareChainParams(_fork, SealEngine::NoReward, _test.Pre(), _test.Env(), ParamsContext::StateTests);
+        session.test_setChainParams(p);
+    }
+
+    // Run transactions for defined expect sections only
+    for (size_t iExpect = 0; iExpect < _test.Expects().size(); iExpect++)
+    {
+        auto const& expect = _test.Expects().at(iExpect);
+        // if expect section for this networks
+        if (expect.hasFork(_fork))
+        {
+            char& expectFoundTransaction = cellResults.expectFound.at(iExpect);
+            for (size_t iTx = _cell.txBegin; iTx < _cell.txEnd; iTx++)
+            {
+                auto& tr = _txs.at(iTx);
+                TestInfo errorInfo(_fork.asString(), tr.dataInd(), tr.gasInd(), tr.valueInd());
+                if (!tr.transaction()->dataLabel().empty() || !tr.transaction()->dataRawPreview().empty())
+                    errorInfo.setTrDataDebug(tr.transaction()->dataLabel() + " " + tr.transaction()->dataRawPreview() + "..");
+
+                TestOutputHelper::get().setCurrentTestInfo(errorInfo);
+
+                bool expectChekIndexes = expect.checkIndexes(tr.dataInd(), tr.gasInd(), tr.valueInd());
+                if (!OptionsAllowTransaction(tr) || networkSkip)
+                {
+                    tr.markSkipped();
+
+                    if (expectChekIndexes)
+                        expectFoundTransaction = true;
+                    continue;
+                }
+
+                // if expect section is not for this transaction
+                if (!expectChekIndexes)
+                    continue;
+
+                expectFoundTransaction = true;
+                session.test_modifyTimestamp(_test.Env().firstBlockTimestamp());
+                FH32 trHash(session.eth_sendRawTransaction(tr.transaction()->getRawBytes(), tr.transaction()->getSecret()));
+
+                MineBlocksResult const mRes = session.test_mineBlocks(1);
+                string const& testException = expect.getExpectException(_fork);
+                compareTransactionException(tr.transaction(), mRes, testException);
+
+                VALUE latestBlockN(session.eth_blockNumber());
+                EthGetBlockBy blockInfo(session.eth_getBlockByNumber(latestBlockN, Request::LESSOBJECTS));
+                if (!blockInfo.hasTransaction(trHash) && testException.empty())
+                    ETH_ERROR_MESSAGE("StateTest::FillTest: " + c_trHashNotFound);
+                tr.markExecuted();
+
+                if (Options::get().poststate)
+                    ETH_STDOUT_MESSAGE("PostState " + TestOutputHelper::get().testInfo().errorDebug() + " : \n" + cDefault +
+                                       "Hash: " + blockInfo.header()->stateRoot().asString());
+
+                if (Options::get().vmtrace)
+                    printVmTrace(session, trHash, blockInfo.header()->stateRoot());
+                try
+                {
+                    compareStates(expect.result(), getRemoteState(session));
+                }
+                catch(StateTooBig const&)
+                {
+                    compareStates(expect.result(), session);
+                }
+
+                spDataObject indexes;
+                spDataObject transactionResults;
+                (*indexes)["data"] = tr.dataInd();
+                (*indexes)["gas"] = tr.gasInd();
+                (*indexes)["value"] = tr.valueInd();
+
+                (*transactionResults).atKeyPointer("indexes") = indexes;
+                (*transactionResults)["hash"] = blockInfo.header()->stateRoot().asString();
+                (*transactionResults)["txbytes"] = tr.transaction()->getRawBytes().asString();
+                if (!testException.empty())
+                    (*transactionResults)["expectException"] = testException;
+
+                // Fill up the loghash (optional)
+                if (Options::getDynamicOptions().getCurrentConfig().cfgFile().checkLogsHash())
+                {
+                    FH32 logHash(session.test_getLogHash(trHash));
+                    if (!logHash.isZero())
+                        (*transactionResults)["logs"] = logHash.asString();
+                }
+
+                cellResults.results.emplace(std::make_pair(iExpect, iTx), transactionResults);
+                session.test_rewindToBlock(VALUE(0));
+            }  // tx
+        }  // expect has fork
+    }
+
+    return cellResults;
+}
+
 /// Rewrite the test file. Fill General State Test
 spDataObject FillTest(StateTestInFiller const& _test)
 {
     spDataObject filledTest;
     TestOutputHelper::get().setCurrentTestName(_test.testName());
 
-    SessionInterface& session = RPCSession::instance(TestOutputHelper::getThreadID());
-
     if (_test.hasInfo())
         (*filledTest).atKeyPointer("_info") = _test.Info().rawData();
     (*filledTest).atKeyPointer("env") = _test.Env().asDataObject();
@@ -247,122 +521,177 @@ spDataObject FillTest(StateTestInFiller const& _test)
     }
 
     // run transactions on all networks that we need
-    for (auto const& fork : _test.getAllForksFromExpectSections())  // object constructed!!!
-    {
-        // Skip by --singlenet option
-        bool networkSkip = false;
-        Options const& opt = Options::get();
-
-        if ((!opt.singleTestNet.empty() && FORK(opt.singleTestNet) != fork) ||
-            !Options::getDynamicOptions().getCurrentConfig().checkForkAllowed(fork))
-            networkSkip = true;
-
-        spDataObject forkResults;
-        (*forkResults).setKey(fork.asString());
+    std::set<FORK> const forkSet = _test.getAllForksFromExpectSections();
+    std::vector<FORK> const forks(forkSet.begin(), forkSet.end());
+    std::vector<TestCell> const cells = makeTestCells(forks.size(), txs.size());
+    std::vector<FillCellResults> cellResults(cells.size());
+    auto buildTxs = [&_test]() { return _test.GeneralTr().buildTransactions(); };
+    auto fillCell = [&_test, &forks, &cells, &cellResults](
+                        size_t _i, std::vector<TransactionInGeneralSection>& _cellTxs, bool _chainParamsSet) {
+        cellResults.at(_i) = FillTestCell(_test, forks.at(cells.at(_i).fork), cells.at(_i), _cellTxs, _chainParamsSet);
+    };
+    runCellJobs(cells, txs, buildTxs, fillCell);
+    if (ExitHandler::receivedExitSignal())
+        return filledTest;
 
-        if (!networkSkip)
+    // Merge in the order of forks, expect sections and transactions, same as sequential execution
+    for (size_t iFork = 0; iFork < forks.size(); iFork++)
+    {
+        std::map<std::pair<size_t, size_t>, spDataObject> forkCellResults;
+        std::vector<char> expectFound(_test.Expects().size(), false);
+        for (size_t iCell = 0; iCell < cells.size(); iCell++)
         {
-            auto const p = prepareChainParams(fork, SealEngine::NoReward, _test.Pre(), _test.Env(), ParamsContext::StateTests);
-            session.test_setChainParams(p);
+            if (cells.at(iCell).fork != iFork)
+                continue;
+            FillCellResults const& cell = cellResults.at(iCell);
+            forkCellResults.insert(cell.results.begin(), cell.results.end());
+            for (size_t k = 0; k < expectFound.size(); k++)
+                expectFound.at(k) = expectFound.at(k) || cell.expectFound.at(k);
         }
 
-        // Run transactions for defined expect sections only
-        for (auto const& expect : _test.Expects())
+        for (size_t k = 0; k < expectFound.size(); k++)
         {
-            // if expect section for this networks
-            if (expect.hasFork(fork))
+            auto const& expect = _test.Expects().at(k);
+            if (expect.hasFork(forks.at(iFork)) && !expectFound.at(k))
             {
-                bool expectFoundTransaction = false;
-                for (auto& tr : txs)
-                {
-                    TestInfo errorInfo(fork.asString(), tr.dataInd(), tr.gasInd(), tr.valueInd());
-                    if (!tr.transaction()->dataLabel().empty() || !tr.transaction()->dataRawPreview().empty())
-                        errorInfo.setTrDataDebug(tr.transaction()->dataLabel() + " " + tr.transaction()->dataRawPreview() + "..");
-
-                    TestOutputHelper::get().setCurrentTestInfo(errorInfo);
-
-                    bool expectChekIndexes = expect.checkIndexes(tr.dataInd(), tr.gasInd(), tr.valueInd());
-                    if (!OptionsAllowTransaction(tr) || networkSkip)
-                    {
-                        tr.markSkipped();
+                TestOutputHelper::get().setCurrentTestInfo(TestInfo(forks.at(iFork).asString(), -1, -1, -1));
+                ETH_ERROR_MESSAGE("Expect section does not cover any transaction: \n" + expect.initialData().asJson() +
+                                  "\n" + expect.result().asDataObject()->asJson());
+            }
+        }
 
-                        if (expectChekIndexes)
-                            expectFoundTransaction = true;
-                        continue;
-                    }
+        if (forkCellResults.size() > 0)
+        {
+            spDataObject forkResults;
+            (*forkResults).setKey(forks.at(iFork).asString());
+            for (auto const& result : forkCellResults)
+                (*forkResults).addArrayObject(result.second);
+            (*filledTest)["post"].addSubObject(forkResults);
+        }
+    }
 
-                    // if expect section is not for this transaction
-                    if (!expectChekIndexes)
-                        continue;
+    checkUnexecutedTransactions(txs);
+    verifyFilledTest(_test.unitTestVerify(), filledTest);
+    return filledTest;
+}
 
-                    expectFoundTransaction = true;
-                    session.test_modifyTimestamp(_test.Env().firstBlockTimestamp());
-                    FH32 trHash(session.eth_sendRawTransaction(tr.transaction()->getRawBytes(), tr.transaction()->getSecret()));
+/// Check if the fork is skipped by options or client config. Set _forkNotAllowed if the client does not support it
+bool RunTestForkSkipped(StateTestInFilled const& _test, FORK const& _network, bool& _forkNotAllowed)
+{
+    // If options singlenet select different network or test has network that is not allowed by clinet configs
+    _forkNotAllowed = false;
+    Options const& opt = Options::get();
+    if (!opt.singleTestNet.empty() && FORK(opt.singleTestNet) != _network)
+        return true;
+    if (!Options::getDynamicOptions().getCurrentConfig().checkForkAllowed(_network))
+    {
+        _forkNotAllowed = true;
+        ETH_WARNING("Skipping unsupported fork: " + _network.asString() + " in " + _test.testName());
+        return true;
+    }
+    return false;
+}
 
-                    MineBlocksResult const mRes = session.test_mineBlocks(1);
-                    string const& testException = expect.getExpectException(fork);
-                    compareTransactionException(tr.transaction(), mRes, testException);
+/// Execute the post results of a single cell. Return for each post result if the cell has a transaction for it
+std::vector<char> RunTestCell(StateTestInFilled const& _test, FORK const& _network, bool _networkSkip,
+    StateTestPostResults const& _results, TestCell const& _cell, std::vector<TransactionInGeneralSection>& _txs,
+    bool _chainParamsSet)
+{
+    SessionInterface& session = RPCSession::instance(TestOutputHelper::getThreadID());
+    std::vector<char> resultsFound(_results.size(), false);
+    if (!_networkSkip && !_chainParamsSet)
+    {
+        auto p = prepareChainParams(_network, SealEngine::NoReward, _test.Pre(), _test.Env(), ParamsContext::StateTests);
+        session.test_setChainParams(p);
+    }
 
-                    VALUE latestBlockN(session.eth_blockNumber());
-                    EthGetBlockBy blockInfo(session.eth_getBlockByNumber(latestBlockN, Request::LESSOBJECTS));
-                    if (!blockInfo.hasTransaction(trHash) && testException.empty())
-                        ETH_ERROR_MESSAGE("StateTest::FillTest: " + c_trHashNotFound);
-                    tr.markExecuted();
+    // One test could have many transactions on same chainParams
+    // It is expected that for a setted chainParams there going to be a transaction
+    // Rather then all transactions would be filtered out and not executed at all
 
-                    if (Options::get().poststate)
-                        ETH_STDOUT_MESSAGE("PostState " + TestOutputHelper::get().testInfo().errorDebug() + " : \n" + cDefault +
-                                           "Hash: " + blockInfo.header()->stateRoot().asString());
+    // read all results for a specific fork
+    for (size_t iResult = 0; iResult < _results.size(); iResult++)
+    {
+        StateTestPostResult const& result = _results.at(iResult);
+        char& resultHaveCorrespondingTransaction = resultsFound.at(iResult);
+        // look for a transaction with this indexes and execute it on a client
+        for (size_t iTx = _cell.txBegin; iTx < _cell.txEnd; iTx++)
+        {
+            TransactionInGeneralSection& tr = _txs.at(iTx);
+            if (ExitHandler::receivedExitSignal())
+                return resultsFound;
 
-                    if (Options::get().vmtrace)
-                        printVmTrace(session, trHash, blockInfo.header()->stateRoot());
-                    try
-                    {
-                        compareStates(expect.result(), getRemoteState(session));
-                    }
-                    catch(StateTooBig const&)
-                    {
-                        compareStates(expect.result(), session);
-                    }
+            TestInfo errorInfo(_network.asString(), tr.dataInd(), tr.gasInd(), tr.valueInd());
+            errorInfo.setTrDataDebug(tr.transaction()->dataLabel() + " " + tr.transaction()->dataRawPreview() + "..");
 
-                    spDataObject indexes;
-                    spDataObject transactionResults;
-                    (*indexes)["data"] = tr.dataInd();
-                    (*indexes)["gas"] = tr.gasInd();
-                    (*indexes)["value"] = tr.valueInd();
+            TestOutputHelper::get().setCurrentTestInfo(errorInfo);
+            bool checkIndexes = result.checkIndexes(tr.dataInd(), tr.gasInd(), tr.valueInd());
+            if (checkIndexes)
+                resultHaveCorrespondingTransaction = true;
 
-                    (*transactionResults).atKeyPointer("indexes") = indexes;
-                    (*transactionResults)["hash"] = blockInfo.header()->stateRoot().asString();
-                    (*transactionResults)["txbytes"] = tr.transaction()->getRawBytes().asString();
-                    if (!testException.empty())
-                        (*transactionResults)["expectException"] = testException;
+            if (!OptionsAllowTransaction(tr) || _networkSkip)
+            {
+                tr.markSkipped();
+                continue;
+            }
 
-                    // Fill up the loghash (optional)
-                    if (Options::getDynamicOptions().getCurrentConfig().cfgFile().checkLogsHash())
-                    {
-                        FH32 logHash(session.test_getLogHash(trHash));
-                        if (!logHash.isZero())
-                            (*transactionResults)["logs"] = logHash.asString();
-                    }
+            if (checkIndexes)
+            {
+                session.test_modifyTimestamp(_test.Env().firstBlockTimestamp());
+                FH32 trHash(session.eth_sendRawTransaction(tr.transaction()->getRawBytes(), tr.transaction()->getSecret()));
+
+                MineBlocksResult const mRes = session.test_mineBlocks(1);
+                string const& testException = result.expectException();
+                compareTransactionException(tr.transaction(), mRes, testException);
+
+                VALUE latestBlockN(session.eth_blockNumber());
+                EthGetBlockBy blockInfo(session.eth_getBlockByNumber(latestBlockN, Request::LESSOBJECTS));
+                if (!blockInfo.hasTransaction(trHash) && testException.empty())
+                    ETH_ERROR_MESSAGE("StateTest::RunTest: " + c_trHashNotFound);
+                tr.markExecuted();
+
+                // Validate post state
+                FH32 const& expectedPostHash = result.hash();
+                if (Options::get().vmtrace && !Options::get().filltests)
+                    printVmTrace(session, trHash, blockInfo.header()->stateRoot());
+
+                FH32 const& actualHash = blockInfo.header()->stateRoot();
+                if (actualHash != expectedPostHash)
+                {
+                    if (Options::get().logVerbosity >= 5)
+                        ETH_LOG("\nState Dump: \n" + getRemoteState(session).asDataObject()->asJson(), 5);
+                    ETH_ERROR_MESSAGE("Post hash mismatch remote: " + actualHash.asString() +
+                                      ", expected: " + expectedPostHash.asString());
+                }
+                if (Options::get().poststate)
+                    ETH_LOG("\nRunning test State Dump:" + TestOutputHelper::get().testInfo().errorDebug() + cDefault + " \n" + getRemoteState(session).asDataObject()->asJson(), 1);
 
-                    (*forkResults).addArrayObject(transactionResults);
-                    session.test_rewindToBlock(VALUE(0));
-                }  // tx
+                // Validate that txbytes field has the transaction data described in test `transaction` field.
+                spBYTES const& expectedBytesPtr = result.bytesPtr();
+                if (!expectedBytesPtr.isEmpty())
+                {
+                    if (tr.transaction()->getRawBytes().asString() != expectedBytesPtr->asString())
+                        ETH_ERROR_MESSAGE("TxBytes mismatch: test transaction section doest not match txbytes in post section!");
+                }
 
-                if (expectFoundTransaction == false)
+                // Validate log hash
+                if (Options::getDynamicOptions().getCurrentConfig().cfgFile().checkLogsHash())
                 {
-                    ETH_ERROR_MESSAGE("Expect section does not cover any transaction: \n" + expect.initialData().asJson() +
-                                      "\n" + expect.result().asDataObject()->asJson());
+                    FH32 const& expectedLogHash = result.logs();
+                    FH32 remoteLogHash(session.test_getLogHash(trHash));
+                    if (remoteLogHash != expectedLogHash)
+                        ETH_ERROR_MESSAGE("Logs hash mismatch: '" + remoteLogHash.asString() + "', expected: '" +
+                                          expectedLogHash.asString() + "'");
                 }
-            }  // expect has fork
-        }
 
-        if (forkResults->getSubObjects().size() > 0)
-            (*filledTest)["post"].addSubObject(forkResults);
+                session.test_rewindToBlock(0);
+                if (Options::get().logVerbosity >= 5)
+                    ETH_LOG("Executed: d: " + to_string(tr.dataInd()) + ", g: " + to_string(tr.gasInd()) +
+                                ", v: " + to_string(tr.valueInd()) + ", fork: " + _network.asString(), 5);
+            }
+        } //ForTransactions
     }
-
-    checkUnexecutedTransactions(txs);
-    verifyFilledTest(_test.unitTestVerify(), filledTest);
-    return filledTest;
+    return resultsFound;
 }
 
 /// Read and execute the test file
@@ -372,138 +701,64 @@ void RunTest(StateTestInFilled const& _test)
         return;
 
     TestOutputHelper::get().setCurrentTestName(_test.testName());
-    SessionInterface& session = RPCSession::instance(TestOutputHelper::getThreadID());
 
     // Gather Transactions from general transaction section
     std::vector<TransactionInGeneralSection> txs = _test.GeneralTr().buildTransactions();
+    assignTransactionLabels(_test, txs);
 
-    // Recover transaction labels from filled test _info section
-    for (auto const& _infoLabels : _test.testInfo().labels())
+    std::vector<FORK> forks;
+    std::vector<StateTestPostResults const*> forkResults;
+    for (auto const& post : _test.Post())
     {
-        // find a transaction with such index
-        // might make sense having el.dataIndString()
-        auto res = std::find_if(txs.begin(), txs.end(),
-            [&_infoLabels](TransactionInGeneralSection const& el) { return el.dataIndS() == _infoLabels.first; });
-        if (res != txs.end())
-            (*res).assignTransactionLabel(":label " + _infoLabels.second);
-        else
-            ETH_WARNING("Test `_info` section has a label with tr.index that was not found!");
+        forks.push_back(post.first);
+        forkResults.push_back(&post.second);
     }
 
-
-    bool forkNotAllowed = false;
-
-    for (auto const& post : _test.Post())
+    std::vector<char> forkSkipped(forks.size(), false);
+    std::vector<char> forkNotAllowed(forks.size(), false);
+    for (size_t i = 0; i < forks.size(); i++)
     {
-        bool networkSkip = false;
-        FORK const& network = post.first;
-        Options const& opt = Options::get();
-
-        // If options singlenet select different network or test has network that is not allowed by clinet configs
-        if (!opt.singleTestNet.empty() && FORK(opt.singleTestNet) != network)
-            networkSkip = true;
-        else if (!Options::getDynamicOptions().getCurrentConfig().checkForkAllowed(network))
-        {
-            networkSkip = true;
-            forkNotAllowed = true;
-            ETH_WARNING("Skipping unsupported fork: " + network.asString() + " in " + _test.testName());
-        }
-        else
-        {
-            auto p = prepareChainParams(network, SealEngine::NoReward, _test.Pre(), _test.Env(), ParamsContext::StateTests);
-            session.test_setChainParams(p);
-        }
+        bool notAllowed = false;
+        forkSkipped.at(i) = RunTestForkSkipped(_test, forks.at(i), notAllowed);
+        forkNotAllowed.at(i) = notAllowed;
+    }
 
-        // One test could have many transactions on same chainParams
-        // It is expected that for a setted chainParams there going to be a transaction
-        // Rather then all transactions would be filtered out and not executed at all
+    std::vector<TestCell> const cells = makeTestCells(forks.size(), txs.size());
+    std::vector<std::vector<char>> cellResultsFound(cells.size());
+    auto buildTxs = [&_test]() {
+        std::vector<TransactionInGeneralSection> cellTxs = _test.GeneralTr().buildTransactions();
+        assignTransactionLabels(_test, cellTxs);
+        return cellTxs;
+    };
+    auto runCell = [&_test, &forks, &forkResults, &forkSkipped, &cells, &cellResultsFound](
+                       size_t _i, std::vector<TransactionInGeneralSection>& _cellTxs, bool _chainParamsSet) {
+        TestCell const& cell = cells.at(_i);
+        cellResultsFound.at(_i) = RunTestCell(_test, forks.at(cell.fork), forkSkipped.at(cell.fork),
+            *forkResults.at(cell.fork), cell, _cellTxs, _chainParamsSet);
+    };
+    runCellJobs(cells, txs, buildTxs, runCell);
+    if (ExitHandler::receivedExitSignal())
+        return;
 
-        // read all results for a specific fork
-        for (StateTestPostResult const& result : post.second)
+    // Every post result must have a transaction in one of the cells of its fork
+    for (size_t iFork = 0; iFork < forks.size(); iFork++)
+    {
+        StateTestPostResults const& results = *forkResults.at(iFork);
+        for (size_t k = 0; k < results.size(); k++)
         {
-            bool resultHaveCorrespondingTransaction = false;
-            // look for a transaction with this indexes and execute it on a client
-            for (TransactionInGeneralSection& tr : txs)
+            bool found = false;
+            for (size_t iCell = 0; iCell < cells.size() && !found; iCell++)
+                found = cells.at(iCell).fork == iFork && cellResultsFound.at(iCell).at(k);
+            if (!found)
             {
-                if (ExitHandler::receivedExitSignal())
-                    return;
-
-                TestInfo errorInfo(network.asString(), tr.dataInd(), tr.gasInd(), tr.valueInd());
-                errorInfo.setTrDataDebug(tr.transaction()->dataLabel() + " " + tr.transaction()->dataRawPreview() + "..");
-
-                TestOutputHelper::get().setCurrentTestInfo(errorInfo);
-                bool checkIndexes = result.checkIndexes(tr.dataInd(), tr.gasInd(), tr.valueInd());
-                if (checkIndexes)
-                    resultHaveCorrespondingTransaction = true;
-
-                if (!OptionsAllowTransaction(tr) || networkSkip)
-                {
-                    tr.markSkipped();
-                    continue;
-                }
-
-                if (checkIndexes)
-                {
-                    session.test_modifyTimestamp(_test.Env().firstBlockTimestamp());
-                    FH32 trHash(session.eth_sendRawTransaction(tr.transaction()->getRawBytes(), tr.transaction()->getSecret()));
-
-                    MineBlocksResult const mRes = session.test_mineBlocks(1);
-                    string const& testException = result.expectException();
-                    compareTransactionException(tr.transaction(), mRes, testException);
-
-                    VALUE latestBlockN(session.eth_blockNumber());
-                    EthGetBlockBy blockInfo(session.eth_getBlockByNumber(latestBlockN, Request::LESSOBJECTS));
-                    if (!blockInfo.hasTransaction(trHash) && testException.empty())
-                        ETH_ERROR_MESSAGE("StateTest::RunTest: " + c_trHashNotFound);
-                    tr.markExecuted();
-
-                    // Validate post state
-                    FH32 const& expectedPostHash = result.hash();
-                    if (Options::get().vmtrace && !Options::get().filltests)
-                        printVmTrace(session, trHash, blockInfo.header()->stateRoot());
-
-                    FH32 const& actualHash = blockInfo.header()->stateRoot();
-                    if (actualHash != expectedPostHash)
-                    {
-                        if (Options::get().logVerbosity >= 5)
-                            ETH_LOG("\nState Dump: \n" + getRemoteState(session).asDataObject()->asJson(), 5);
-                        ETH_ERROR_MESSAGE("Post hash mismatch remote: " + actualHash.asString() +
-                                          ", expected: " + expectedPostHash.asString());
-                    }
-                    if (Options::get().poststate)
-                        ETH_LOG("\nRunning test State Dump:" + TestOutputHelper::get().testInfo().errorDebug() + cDefault + " \n" + getRemoteState(session).asDataObject()->asJson(), 1);
-
-                    // Validate that txbytes field has the transaction data described in test `transaction` field.
-                    spBYTES const& expectedBytesPtr = result.bytesPtr();
-                    if (!expectedBytesPtr.isEmpty())
-                    {
-                        if (tr.transaction()->getRawBytes().asString() != expectedBytesPtr->asString())
-                            ETH_ERROR_MESSAGE("TxBytes mismatch: test transaction section doest not match txbytes in post section!");
-                    }
-
-                    // Validate log hash
-                    if (Options::getDynamicOptions().getCurrentConfig().cfgFile().checkLogsHash())
-                    {
-                        FH32 const& expectedLogHash = result.logs();
-                        FH32 remoteLogHash(session.test_getLogHash(trHash));
-                        if (remoteLogHash != expectedLogHash)
-                            ETH_ERROR_MESSAGE("Logs hash mismatch: '" + remoteLogHash.asString() + "', expected: '" +
-                                              expectedLogHash.asString() + "'");
-                    }
-
-                    session.test_rewindToBlock(0);
-                    if (Options::get().logVerbosity >= 5)
-                        ETH_LOG("Executed: d: " + to_string(tr.dataInd()) + ", g: " + to_string(tr.gasInd()) +
-                                    ", v: " + to_string(tr.valueInd()) + ", fork: " + network.asString(), 5);
-                }
-            } //ForTransactions
-
-            ETH_ERROR_REQUIRE_MESSAGE(resultHaveCorrespondingTransaction,
-                "Test `post` section has expect section without corresponding transaction!" + result.asDataObject()->asJson());
+                TestOutputHelper::get().setCurrentTestInfo(TestInfo(forks.at(iFork).asString(), -1, -1, -1));
+                ETH_ERROR_MESSAGE("Test `post` section has expect section without corresponding transaction!" +
+                                  results.at(k).asDataObject()->asJson());
+            }
         }
     }
 
-    if (!forkNotAllowed)
+    if (std::find(forkNotAllowed.begin(), forkNotAllowed.end(), true) == forkNotAllowed.end())
         checkUnexecutedTransactions(txs);
 }
 }  // namespace closed
@@ -11,16 +11,9 @@ using namespace test;
 namespace fs = boost::filesystem;
 namespace
 {
-spDataObject FillTest(TransactionTestInFiller const& _test)
+// Forks the filler is generated for
+std::vector<FORK> fillForks(TransactionTestInFiller const& _test)
 {
-    spDataObject filledTest;
-    TestOutputHelper::get().setCurrentTestName(_test.testName());
-
-    SessionInterface& session = RPCSession::instance(TestOutputHelper::getThreadID());
-
-    if (_test.hasInfo())
-        (*filledTest).atKeyPointer("_info") = _test.info().rawData();
-
     std::set<FORK> executionForks;
     for (auto const& fork : Options::getCurrentConfig().cfgFile().forks())
         executionForks.emplace(fork);
@@ -32,16 +25,85 @@ spDataObject FillTest(TransactionTestInFiller const& _test)
             ETH_WARNING("Client config does not support fork `" + fork.asString() + "`, skipping test generation!");
     }
 
+    std::vector<FORK> forks;
+    Options const& opt = Options::get();
     for (auto const& fork : executionForks)
     {
-        if (ExitHandler::receivedExitSignal())
-            break;
+        if (!opt.singleTestNet.empty() && FORK(opt.singleTestNet) != fork)
+            continue;
+        forks.push_back(fork);
+    }
+    return forks;
+}
 
-        Options const& opt = Options::get();
+// Forks the filled test is executed on
+std::vector<FORK> runForks(TransactionTestInFilled const& _test)
+{
+    std::vector<FORK> forks;
+    Options const& opt = Options::get();
+    for (auto const& fork : _test.allForks())
+    {
         if (!opt.singleTestNet.empty() && FORK(opt.singleTestNet) != fork)
             continue;
 
-        TestRawTransaction res = session.test_rawTransaction(_test.transaction()->getRawBytes(), fork);
+        if (!Options::getDynamicOptions().getCurrentConfig().checkForkAllowed(fork))
+        {
+            ETH_WARNING("Client config does not support fork `" + fork.asString() + "`, skipping test!");
+            continue;
+        }
+        forks.push_back(fork);
+    }
+    return forks;
+}
+
+// Validation results of the test transaction on each fork
+typedef std::vector<std::pair<FORK, TestRawTransaction>> ForkResults;
+
+// Validate transactions of all tests of the file in one session call
+template <class T, class GetForks, class GetRlp>
+std::vector<ForkResults> validateTransactions(std::vector<T> const& _tests, GetForks _getForks, GetRlp _getRlp)
+{
+    std::vector<RawTransactionRequest> requests;
+    std::vector<std::vector<FORK>> testForks;
+    for (auto const& test : _tests)
+    {
+        TestOutputHelper::get().setCurrentTestName(test.testName());
+        testForks.push_back(_getForks(test));
+        for (auto const& fork : testForks.back())
+            requests.push_back({spBYTES(new BYTES(_getRlp(test))), spFORK(new FORK(fork))});
+    }
+
+    SessionInterface& session = RPCSession::instance(TestOutputHelper::getThreadID());
+    std::vector<TestRawTransaction> const responses = session.test_rawTransactionBatch(requests);
+    ETH_FAIL_REQUIRE_MESSAGE(responses.size() == requests.size(),
+        "test_rawTransactionBatch returned " + fto_string(responses.size()) + " results for " +
+            fto_string(requests.size()) + " transactions");
+
+    std::vector<ForkResults> results;
+    size_t k = 0;
+    for (auto const& forks : testForks)
+    {
+        ForkResults testResults;
+        for (auto const& fork : forks)
+            testResults.push_back({fork, responses.at(k++)});
+        results.push_back(testResults);
+    }
+    return results;
+}
+
+spDataObject FillTest(TransactionTestInFiller const& _test, ForkResults const& _results)
+{
+    spDataObject filledTest;
+    TestOutputHelper::get().setCurrentTestName(_test.testName());
+
+    if (_test.hasInfo())
+        (*filledTest).atKeyPointer("_info") = _test.info().rawData();
+
+    for (auto const& [fork, res] : _results)
+    {
+        if (ExitHandler::receivedExitSignal())
+            break;
+
         compareTransactionException(_test.transaction(), res, _test.getExpectException(fork));
 
         spDataObject result;
@@ -61,26 +123,14 @@ spDataObject FillTest(TransactionTestInFiller const& _test)
     return filledTest;
 }
 
-void RunTest(TransactionTestInFilled const& _test)
+void RunTest(TransactionTestInFilled const& _test, ForkResults const& _results)
 {
     TestOutputHelper::get().setCurrentTestName(_test.testName());
-    SessionInterface& session = RPCSession::instance(TestOutputHelper::getThreadID());
-    for (auto const& fork : _test.allForks())
+    for (auto const& [fork, res] : _results)
     {
         if (ExitHandler::receivedExitSignal())
             break;
 
-        Options const& opt = Options::get();
-        if (!opt.singleTestNet.empty() && FORK(opt.singleTestNet) != fork)
-            continue;
-
-        if (!Options::getDynamicOptions().getCurrentConfig().checkForkAllowed(fork))
-        {
-            ETH_WARNING("Client config does not support fork `" + fork.asString() + "`, skipping test!");
-            continue;
-        }
-
-        TestRawTransaction res = session.test_rawTransaction(_test.rlp(), fork);
         if (_test.transaction().isEmpty())
         {
             // Retesteth was unable to read the transaction rlp from the test into a valid transaction
@@ -131,11 +181,14 @@ spDataObject TransactionTestSuite::doTests(spDataObject& _input, TestSuiteOption
         spDataObject filledTest;
         TransactionTestFiller filler(_input);
 
-        for (auto const& test : filler.tests())
+        auto const results = validateTransactions(filler.tests(), fillForks,
+            [](TransactionTestInFiller const& _test) { return _test.transaction()->getRawBytes(); });
+        for (size_t i = 0; i < filler.tests().size(); i++)
         {
             if (ExitHandler::receivedExitSignal())
                 break;
-            (*filledTest).addSubObject(test.testName(), FillTest(test));
+            auto const& test = filler.tests().at(i);
+            (*filledTest).addSubObject(test.testName(), FillTest(test, results.at(i)));
             TestOutputHelper::get().registerTestRunSuccess();
         }
         return filledTest;
@@ -147,11 +200,13 @@ spDataObject TransactionTestSuite::doTests(spDataObject& _input, TestSuiteOption
         if (Options::get().checkhash)
             return spDataObject();
 
-        for (auto const& test : filledTest.tests())
+        auto const results = validateTransactions(
+            filledTest.tests(), runForks, [](TransactionTestInFilled const& _test) { return _test.rlp(); });
+        for (size_t i = 0; i < filledTest.tests().size(); i++)
         {
             if (ExitHandler::receivedExitSignal())
                 break;
-            RunTest(test);
+            RunTest(filledTest.tests().at(i), results.at(i));
             TestOutputHelper::get().registerTestRunSuccess();
         }
     }
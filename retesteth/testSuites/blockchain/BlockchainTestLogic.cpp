@@ -87,7 +87,8 @@ void RunTest(BlockchainTestInFilled const& _test, TestSuite::TestSuiteOptions co
                 ETH_ERROR_MESSAGE(
                     "Importing raw RLP block, block was expected to be valid! (if it was intended, check that it is not in Valid blocks test suite) " + session.getLastRPCError().message());
 
-            if (Options::getDynamicOptions().getCurrentConfig().cfgFile().socketType() == ClientConfgSocketType::TransitionTool)
+            auto const socketType = Options::getDynamicOptions().getCurrentConfig().cfgFile().socketType();
+            if (socketType == ClientConfgSocketType::TransitionTool || socketType == ClientConfgSocketType::TransitionLibrary)
             {
                 string const& sBlockException = tblock.getExpectException();
                 if (!sBlockException.empty())
@@ -109,9 +110,7 @@ void RunTest(BlockchainTestInFilled const& _test, TestSuite::TestSuiteOptions co
                 printVmTrace(session, tr->hash(), latestBlock.header()->stateRoot());
         }
 
-        spDataObject remoteHeader = latestBlock.header()->asDataObject();
-        spDataObject testHeader = tblock.header()->asDataObject();
-        bool condition = remoteHeader->asJson(0, false) == testHeader->asJson(0, false);
+        bool condition = latestBlock.header()->equals(tblock.header().getCContent());
         /*if (_opt.isLegacyTests)
         {
             inTestHeader = bdata.atKey("blockHeader");  // copy!!!
@@ -135,7 +134,7 @@ void RunTest(BlockchainTestInFilled const& _test, TestSuite::TestSuiteOptions co
         {
             string errField;
             message = "Client return HEADER vs Test HEADER: \n";
-            message += compareBlockHeaders(remoteHeader.getCContent(), testHeader.getCContent(), errField);
+            message += latestBlock.header()->diff(tblock.header().getCContent(), errField);
         }
         ETH_ERROR_REQUIRE_MESSAGE(
             condition, "Client report different blockheader after importing the rlp than expected by test! \n" + message);
@@ -332,7 +332,8 @@ FH32 TestBlockchain::postmineBlockHeader(BlockchainTestFillerBlock const& _block
     // if blockHeader is defined in test Filler, rewrite the last block header fields with info from
     // test and reimport it to the client in order to trigger an exception in the client
     EthGetBlockBy remoteBlock(m_session.eth_getBlockByNumber(_latestBlockNumber, Request::FULLOBJECTS));
-    EthereumBlock managedBlock(remoteBlock.header());
+    // The header may be shared with the block in the tool backend chain, modify a copy
+    EthereumBlock managedBlock(readBlockHeader(remoteBlock.header()->asDataObject()));
     for (auto const& tr : remoteBlock.transactions())  // + invalid transactions?
         managedBlock.addTransaction(tr.transaction());
 
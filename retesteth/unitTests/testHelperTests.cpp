@@ -19,11 +19,18 @@
  */
 
 #include <libdevcore/CommonIO.h>
+#include <libdevcore/RLP.h>
+#include <retesteth/SpawnServer.h>
 #include <retesteth/TestHelper.h>
 #include <retesteth/TestOutputHelper.h>
 #include <retesteth/configs/ClientConfig.h>
+#include <retesteth/testSuiteRunner/TestTimings.h>
 #include <boost/test/unit_test.hpp>
 #include <retesteth/Options.h>
+#include <signal.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <unistd.h>
 
 using namespace std;
 using namespace dev;
@@ -261,4 +268,107 @@ BOOST_AUTO_TEST_CASE(getTestSuggestions2)
     BOOST_CHECK(test::inArray(list, string("BCGeneralStateTests/stExample")));
 }
 
+BOOST_AUTO_TEST_CASE(resolveCmdPath_cache)
+{
+    resetCmdPathCache();
+    CmdPathCacheStats const before = cmdPathCacheStats();
+    string const sh = resolveCmdPath("sh");
+    BOOST_CHECK(!sh.empty() && sh[0] == '/');
+    BOOST_CHECK_EQUAL(resolveCmdPath("sh"), sh);
+    BOOST_CHECK(resolveCmdPath("retesteth-no-such-command").empty());
+    BOOST_CHECK(!checkCmdExist("retesteth-no-such-command --version"));
+
+    CmdPathCacheStats const after = cmdPathCacheStats();
+    BOOST_CHECK_EQUAL(after.resolved - before.resolved, 2u);
+    BOOST_CHECK_EQUAL(after.saved - before.saved, 2u);
+}
+
+BOOST_AUTO_TEST_CASE(executeCmdWithInput_stdinStdout)
+{
+    string const input = string(200000, 'a') + "\nlast line";
+    BOOST_CHECK_EQUAL(executeCmdWithInput("cat", input), input);
+    BOOST_CHECK_EQUAL(executeCmdWithInput("sh -c 'echo retesteth'", string()), "retesteth");
+}
+
+BOOST_AUTO_TEST_CASE(executeCmdWithInput_exitCode)
+{
+    // The error reports the exit code, not the raw wait status
+    TestOutputHelper::get().setUnitTestExceptions({"exited with 3 code"});
+    BOOST_CHECK_EQUAL(executeCmdWithInput("sh -c 'cat; exit 3'", "output", ExecCMDWarning::NoWarning), "output");
+    BOOST_CHECK(TestOutputHelper::get().getUnitTestExceptions().empty());
+}
+
+BOOST_AUTO_TEST_CASE(spawnServer_stdinStdout)
+{
+    SpawnedCmd cmd = SpawnServer::spawn("cat");
+    BOOST_REQUIRE(cmd.pid > 0);
+    string const input(200000, 'a');
+    size_t sent = 0;
+    while (sent < input.size())
+    {
+        ssize_t const res = send(cmd.fdIn, input.data() + sent, input.size() - sent, MSG_NOSIGNAL);
+        BOOST_REQUIRE(res > 0);
+        sent += (size_t)res;
+    }
+    close(cmd.fdIn);
+    cmd.fdIn = -1;
+
+    string output;
+    char buffer[4096];
+    ssize_t res;
+    while ((res = read(cmd.fdOut, buffer, sizeof(buffer))) > 0)
+        output.append(buffer, (size_t)res);
+    BOOST_CHECK(output == input);
+
+    int const status = SpawnServer::wait(cmd);
+    BOOST_CHECK(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+    BOOST_CHECK_EQUAL(cmd.pid, 0);
+}
+
+BOOST_AUTO_TEST_CASE(spawnServer_exitCode)
+{
+    SpawnedCmd cmd = SpawnServer::spawn("exit 5");
+    int const status = SpawnServer::wait(cmd);
+    BOOST_CHECK(WIFEXITED(status));
+    BOOST_CHECK_EQUAL(WEXITSTATUS(status), 5);
+}
+
+BOOST_AUTO_TEST_CASE(spawnServer_processGroup)
+{
+    // The child leads its own group, killing the group stops the shell and its children
+    SpawnedCmd cmd = SpawnServer::spawn("sleep 60 & wait", true);
+    BOOST_REQUIRE(cmd.pid > 0);
+    BOOST_CHECK_EQUAL(getpgid(cmd.pid), cmd.pid);
+    kill(-cmd.pid, SIGTERM);
+    int const status = SpawnServer::wait(cmd);
+    BOOST_CHECK(WIFSIGNALED(status) && WTERMSIG(status) == SIGTERM);
+}
+
+BOOST_AUTO_TEST_CASE(rlpStreamU_multipleItems)
+{
+    string const legacy = "0x" + toHex(dev::RLPStream(2).append(u256(1)).append(bytes(60, 0xaa)).out());
+    string const typed = "0x01" + string(120, 'b');
+
+    test::RLPStreamU single(1);
+    single.appendRaw(legacy);
+    BOOST_CHECK_EQUAL(single.out(), single.outHeader() + legacy.substr(2));
+
+    test::RLPStreamU txsout(2);
+    txsout.appendRaw(legacy);
+    txsout.appendString(typed);
+    dev::RLPStream expected(2);
+    expected.appendRaw(fromHex(legacy));
+    expected.append(fromHex(typed));
+    BOOST_CHECK_EQUAL(txsout.out(), "0x" + toHex(expected.out()));
+}
+
+BOOST_AUTO_TEST_CASE(testTimings_makespan)
+{
+    // Longest first fills the workers evenly, the heavy job last defines the makespan
+    BOOST_CHECK_EQUAL(TestTimings::makespan({8, 4, 3, 3, 2}, 2), 10);
+    BOOST_CHECK_EQUAL(TestTimings::makespan({2, 3, 3, 4, 8}, 2), 13);
+    BOOST_CHECK_EQUAL(TestTimings::makespan({5, 1}, 0), 6);
+    BOOST_CHECK_EQUAL(TestTimings::makespan({}, 4), 0);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,396 @@
+/*
+    This file is part of cpp-ethereum.
+
+    cpp-ethereum is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    cpp-ethereum is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with cpp-ethereum.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/** @file toolBackendTests.cpp
+ * Unit tests for t8ntool backend helpers.
+ */
+
+#include <libdevcore/CommonIO.h>
+#include <retesteth/Options.h>
+#include <retesteth/TestHelper.h>
+#include <retesteth/TestOutputHelper.h>
+#include <retesteth/session/ToolBackend/GenesisCache.h>
+#include <retesteth/session/ToolBackend/ToolChainHelper.h>
+#include <retesteth/session/ToolBackend/ToolImplHelper.h>
+#include <retesteth/session/ToolBackend/ToolLibrary.h>
+#include <retesteth/session/ToolBackend/ToolServer.h>
+#include <retesteth/session/ToolBackend/ToolStateReader.h>
+#include <retesteth/session/ToolBackend/TransitionCache.h>
+#include <retesteth/testStructures/types/Ethereum/BlockHeaderReader.h>
+#include <retesteth/testStructures/types/RPC/ToolResponse.h>
+#include <dataObject/ConvertFile.h>
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+using namespace dev;
+using namespace test;
+using namespace toolimpl;
+
+namespace
+{
+// Local stand-in for the t8ntool server: echoes request args and input back in one line
+string const c_standInServer = R"(#!/bin/sh
+while IFS= read -r args && IFS= read -r input; do
+    echo "{\"args\":\"$args\",\"input\":$input}"
+done
+)";
+
+// Point the transition cache to a fresh folder with the given size limit
+class TransitionCacheScope
+{
+public:
+    TransitionCacheScope(size_t _sizeMB) : m_options(const_cast<Options&>(Options::get()))
+    {
+        m_dir = test::createUniqueTmpDirectory();
+        m_prevDir = m_options.toolCacheDir;
+        m_prevSizeMB = m_options.toolCacheSizeMB;
+        m_options.toolCacheDir = m_dir;
+        m_options.toolCacheSizeMB = _sizeMB;
+        TransitionCache::reset();
+    }
+    ~TransitionCacheScope()
+    {
+        m_options.toolCacheDir = m_prevDir;
+        m_options.toolCacheSizeMB = m_prevSizeMB;
+        TransitionCache::reset();
+        fs::remove_all(m_dir);
+    }
+
+private:
+    Options& m_options;
+    fs::path m_dir;
+    boost::optional<fs::path> m_prevDir;
+    size_t m_prevSizeMB;
+};
+
+fs::path deployStandInServer(fs::path const& _dir)
+{
+    fs::path const serverPath = _dir / "server.sh";
+    writeFileExec(serverPath, c_standInServer);
+    return serverPath;
+}
+}  // namespace
+
+BOOST_FIXTURE_TEST_SUITE(ToolBackendSuite, TestOutputHelperFixture)
+
+BOOST_AUTO_TEST_CASE(toolServer_requestResponse)
+{
+    fs::path const tmpDir = test::createUniqueTmpDirectory();
+    fs::path const serverPath = deployStandInServer(tmpDir);
+
+    ToolServer& server = ToolServer::get(serverPath, tmpDir);
+    for (size_t i = 0; i < 3; i++)
+    {
+        string const res = server.request("--state.fork Berlin", "{\n\"alloc\" : " + fto_string(i) + "\n}");
+        BOOST_CHECK_EQUAL(res, "{\"args\":\"--state.fork Berlin\",\"input\":{ \"alloc\" : " + fto_string(i) + " }}");
+    }
+
+    // Same session gets the same server process
+    BOOST_CHECK_EQUAL(&server, &ToolServer::get(serverPath, tmpDir));
+    ToolServer::release(tmpDir);
+    fs::remove_all(tmpDir);
+}
+
+BOOST_AUTO_TEST_CASE(toolStateReader_restoreFullState)
+{
+    string const response = R"({
+        "result" : { "stateRoot" : "0x01" },
+        "alloc" : {
+            "0x095e7baea6a6c7c4c2dfeb977efac326af552d87" : {
+                "code" : "0x600160015500",
+                "storage" : {
+                    "0x0000000000000000000000000000000000000000000000000000000000000001" : "0x0000000000000000000000000000000000000000000000000000000000000102"
+                },
+                "balance" : "0xde0b6b3a7640000"
+            },
+            "0xa94f5374fce5edbc8e2a8697c15331677e6ebf0b" : { "nonce" : "0x1", "secretKey" : "0x45a9" }
+        }
+    })";
+
+    size_t begin = 0, end = 0;
+    BOOST_REQUIRE(findJsonTopLevelValue(response, "alloc", begin, end));
+    BOOST_CHECK(!findJsonTopLevelValue(response, "receipts", begin, end));
+    BOOST_REQUIRE(findJsonTopLevelValue(response, "alloc", begin, end));
+    State const state = readToolAlloc(response, begin, end);
+
+    string const expected = R"({"0x095e7baea6a6c7c4c2dfeb977efac326af552d87":{"code":"0x600160015500","nonce":"0x00","balance":"0x0de0b6b3a7640000","storage":{"0x01":"0x0102"}},"0xa94f5374fce5edbc8e2a8697c15331677e6ebf0b":{"code":"0x","nonce":"0x01","balance":"0x00","storage":{}}})";
+    BOOST_CHECK_EQUAL(state.asJsonAlloc(false), expected);
+}
+
+BOOST_AUTO_TEST_CASE(toolStateReader_leadingZeros)
+{
+    // Storage may have leading zeros, balance and nonce are validated like VALUE
+    State const state = readToolAlloc(R"({"0x095e7baea6a6c7c4c2dfeb977efac326af552d87" :
+        { "balance" : "0x0", "nonce" : "0x00", "storage" : { "0x0001" : "0x000102" } }})");
+    FH20 const contract("0x095e7baea6a6c7c4c2dfeb977efac326af552d87");
+    BOOST_CHECK_EQUAL(state.getAccount(contract).storage().atKey(VALUE(1)).asString(), "0x0102");
+
+    BOOST_CHECK_THROW(readToolAlloc(R"({"0x095e7baea6a6c7c4c2dfeb977efac326af552d87" : { "balance" : "0x0001" }})"),
+        test::UpwardsException);
+    BOOST_CHECK_THROW(readToolAlloc(R"({"0x095e7baea6a6c7c4c2dfeb977efac326af552d87" : { "nonce" : "0x001" }})"),
+        test::UpwardsException);
+}
+
+BOOST_AUTO_TEST_CASE(toolStateReader_shareParentAccounts)
+{
+    string const parentAlloc = R"({
+        "0x095e7baea6a6c7c4c2dfeb977efac326af552d87" : { "code" : "0x6001", "storage" : { "0x01" : "0x02", "0x03" : "0x04" } },
+        "0xa94f5374fce5edbc8e2a8697c15331677e6ebf0b" : { "nonce" : "0x01", "balance" : "0x10" }
+    })";
+    string const childAlloc = R"({
+        "0x095e7baea6a6c7c4c2dfeb977efac326af552d87" : { "code" : "0x6001", "storage" : { "0x01" : "0x02", "0x03" : "0x05" } },
+        "0xa94f5374fce5edbc8e2a8697c15331677e6ebf0b" : { "nonce" : "0x01", "balance" : "0x10" }
+    })";
+
+    State const parent = readToolAlloc(parentAlloc);
+    State const child = readToolAlloc(childAlloc, &parent);
+    FH20 const contract("0x095e7baea6a6c7c4c2dfeb977efac326af552d87");
+    FH20 const sender("0xa94f5374fce5edbc8e2a8697c15331677e6ebf0b");
+
+    // Unchanged account is the same object
+    BOOST_CHECK(&parent.accounts().at(sender).getCContent() == &child.accounts().at(sender).getCContent());
+
+    // Changed account shares code and unchanged storage records
+    AccountBase const& parentContract = parent.accounts().at(contract);
+    AccountBase const& childContract = child.accounts().at(contract);
+    BOOST_CHECK(&parentContract != &childContract);
+    BOOST_CHECK(&parentContract.code() == &childContract.code());
+    BOOST_CHECK(&std::get<1>(parentContract.storage().getKeys().at("0x01")).getCContent() ==
+                &std::get<1>(childContract.storage().getKeys().at("0x01")).getCContent());
+    BOOST_CHECK_EQUAL(childContract.storage().atKey(VALUE(3)).asString(), "0x05");
+}
+
+BOOST_AUTO_TEST_CASE(toolLibrary_stubTransition)
+{
+    // Reference library is built next to retesteth binary
+    fs::path const libPath = fs::read_symlink("/proc/self/exe").parent_path() / "libt8nstub.so";
+    BOOST_REQUIRE_MESSAGE(fs::exists(libPath), "Reference transition library not found: " + libPath.string());
+
+    ToolLibrary& library = ToolLibrary::get(libPath);
+    BOOST_CHECK_EQUAL(&library, &ToolLibrary::get(libPath));
+    BOOST_CHECK(!library.version().empty());
+
+    string const alloc = R"({"0xa94f5374fce5edbc8e2a8697c15331677e6ebf0b":{"balance":"0x10","nonce":"0x01"}})";
+    string const response = library.apply("--state.fork Berlin", alloc, "{}", "\"0xc0\"", true);
+
+    size_t begin = 0, end = 0;
+    BOOST_REQUIRE(findJsonTopLevelValue(response, "result", begin, end));
+    spDataObject result = dataobject::ConvertJsoncppStringToData(response.substr(begin, end - begin));
+    ToolResponse const toolResponse(*result);
+    BOOST_CHECK(toolResponse.receipts().size() == 0);
+
+    BOOST_REQUIRE(findJsonTopLevelValue(response, "alloc", begin, end));
+    BOOST_CHECK_EQUAL(readToolAlloc(response, begin, end).asJsonAlloc(false),
+        R"({"0xa94f5374fce5edbc8e2a8697c15331677e6ebf0b":{"code":"0x","nonce":"0x01","balance":"0x10","storage":{}}})");
+}
+
+BOOST_AUTO_TEST_CASE(difficulty_forkBombDelay)
+{
+    DifficultyStatic const& data = prepareEthereumBlockStateTemplate();
+    spBlockHeader parent = readBlockHeader(data.blockA->asDataObject());
+    spBlockHeader current = readBlockHeader(data.blockA->asDataObject());
+    auto calculate = [&parent, &current](string const& _fork, size_t _number) {
+        ChainOperationParams params;
+        BOOST_REQUIRE(ChainOperationParams::forkParams(FORK(_fork), params));
+        parent.getContent().setNumber(_number - 1);
+        parent.getContent().setTimestamp(0);
+        parent.getContent().setDifficulty(0x20000);
+        parent.getContent().setUnclesHash(FH32("0x1dcc4de8dec75d7aab85b567b6ccd41ad312451b948a7413f0a142fd40d49347"));
+        current.getContent().setNumber(_number);
+        current.getContent().setTimestamp(0);
+        return calculateEthashDifficulty(params, current, parent).asDecString();
+    };
+
+    // 0x20000 + 0x20000 / 2048 without the bomb
+    BOOST_CHECK_EQUAL(calculate("Byzantium", 1), "131136");
+    // Bomb period 9 with EIP-2384 delay, period 2 with EIP-3554 delay
+    BOOST_CHECK_EQUAL(calculate("Berlin", 9900001), "131264");
+    BOOST_CHECK_EQUAL(calculate("London", 9900001), "131137");
+    BOOST_CHECK_EQUAL(calculate("GrayGlacier", 9900001), "131136");
+
+    ChainOperationParams params;
+    BOOST_CHECK(!ChainOperationParams::forkParams(FORK("Merge"), params));
+}
+
+BOOST_AUTO_TEST_CASE(blockHeader_equalsDiff)
+{
+    DifficultyStatic const& data = prepareEthereumBlockStateTemplate();
+    spBlockHeader headerA = readBlockHeader(data.blockA->asDataObject());
+    spBlockHeader headerB = readBlockHeader(data.blockA->asDataObject());
+    BOOST_CHECK(headerA->equals(headerB.getCContent()));
+
+    headerB.getContent().setTimestamp(VALUE(headerA->timestamp() + 1));
+    headerB.getContent().recalculateHash();
+    BOOST_CHECK(!headerA->equals(headerB.getCContent()));
+
+    string errField;
+    string const message = headerA->diff(headerB.getCContent(), errField);
+    BOOST_CHECK_EQUAL(errField, "timestamp");
+    BOOST_CHECK(message.find("hash") != string::npos);
+}
+
+BOOST_AUTO_TEST_CASE(toolImpl_rangeCursors)
+{
+    string const alloc = R"({
+        "0x0000000000000000000000000000000000000000" : { "balance" : "0x01" },
+        "0x0000000000000000000000000000000000000001" : { "balance" : "0x01" },
+        "0x095e7baea6a6c7c4c2dfeb977efac326af552d87" : { "storage" : { "0x01" : "0x02", "0x03" : "0x04", "0x05" : "0x06" } },
+        "0xa94f5374fce5edbc8e2a8697c15331677e6ebf0b" : { "nonce" : "0x01" }
+    })";
+    DifficultyStatic const& data = prepareEthereumBlockStateTemplate();
+    EthereumBlockState const block(readBlockHeader(data.blockA->asDataObject()),
+        spState(new State(readToolAlloc(alloc))), FH32::zero());
+
+    std::vector<string> accounts;
+    FH32 nextKey("0x0000000000000000000000000000000000000000000000000000000000000001");
+    while (!nextKey.isZero())
+    {
+        DebugAccountRange const range = constructAccountRange(block, nextKey, 3);
+        for (auto const& el : range.addresses())
+            accounts.push_back(el->asString());
+        nextKey = range.nextKey();
+    }
+    BOOST_REQUIRE_EQUAL(accounts.size(), 4);
+    BOOST_CHECK_EQUAL(accounts.at(0), "0x0000000000000000000000000000000000000000");
+    BOOST_CHECK_EQUAL(accounts.at(3), "0xa94f5374fce5edbc8e2a8697c15331677e6ebf0b");
+
+    FH20 const contract("0x095e7baea6a6c7c4c2dfeb977efac326af552d87");
+    DebugStorageRangeAt const first = constructStorageRangeAt(block, contract, FH32::zero(), 2);
+    BOOST_CHECK_EQUAL(first.storage().getKeys().size(), 2);
+    BOOST_CHECK_EQUAL(first.nextKey().asString(), "0x0000000000000000000000000000000000000000000000000000000000000005");
+    DebugStorageRangeAt const second = constructStorageRangeAt(block, contract, first.nextKey(), 2);
+    BOOST_CHECK_EQUAL(second.storage().getKeys().size(), 1);
+    BOOST_CHECK(second.storage().hasKey(VALUE(5)));
+    BOOST_CHECK(second.nextKey().isZero());
+}
+
+BOOST_AUTO_TEST_CASE(toolImpl_storageRangeZeroKey)
+{
+    // Key zero in 0x:bigint form is not ordered first. It must not become a cursor (zero means done)
+    string const alloc = R"({
+        "0x095e7baea6a6c7c4c2dfeb977efac326af552d87" : { "balance" : "0x00", "code" : "0x", "nonce" : "0x00",
+            "storage" : { "0x01" : "0x02", "0x03" : "0x04", "0x:bigint 0x00" : "0x06" } }
+    })";
+    spDataObject state = ConvertJsoncppStringToData(alloc);
+    DifficultyStatic const& data = prepareEthereumBlockStateTemplate();
+    EthereumBlockState const block(readBlockHeader(data.blockA->asDataObject()),
+        spState(new State(dataobject::move(state))), FH32::zero());
+
+    FH20 const contract("0x095e7baea6a6c7c4c2dfeb977efac326af552d87");
+    size_t records = 0;
+    bool hasZero = false;
+    FH32 nextKey = FH32::zero();
+    do
+    {
+        DebugStorageRangeAt const range = constructStorageRangeAt(block, contract, nextKey, 1);
+        records += range.storage().getKeys().size();
+        for (auto const& el : range.storage().getKeys())
+            hasZero = hasZero || std::get<0>(el.second).getCContent() == VALUE(0);
+        nextKey = range.nextKey();
+    } while (!nextKey.isZero() && records < 10);
+    BOOST_CHECK_EQUAL(records, 3);
+    BOOST_CHECK(hasZero);
+}
+
+BOOST_AUTO_TEST_CASE(genesisCache_hitMiss)
+{
+    DifficultyStatic const& data = prepareEthereumBlockStateTemplate();
+    EthereumBlockState const genesis(readBlockHeader(data.blockA->asDataObject()),
+        spState(new State(readToolAlloc(R"({"0x0000000000000000000000000000000000000c01" : { "balance" : "0x01" }})"))),
+        FH32::zero());
+
+    string const key = GenesisCache::makeKey(genesis, FORK("Berlin"), "/bin/evm", "evm version 1.0");
+    BOOST_CHECK_EQUAL(key, GenesisCache::makeKey(genesis, FORK("Berlin"), "/bin/evm", "evm version 1.0"));
+    BOOST_CHECK(key != GenesisCache::makeKey(genesis, FORK("London"), "/bin/evm", "evm version 1.0"));
+
+    string root;
+    BOOST_CHECK(!GenesisCache::find(key, root));
+    GenesisCache::insert(key, "0x01");
+    BOOST_REQUIRE(GenesisCache::find(key, root));
+    BOOST_CHECK_EQUAL(root, "0x01");
+}
+
+BOOST_AUTO_TEST_CASE(genesisCache_toolVersionChange)
+{
+    DifficultyStatic const& data = prepareEthereumBlockStateTemplate();
+    EthereumBlockState const genesis(readBlockHeader(data.blockA->asDataObject()),
+        spState(new State(readToolAlloc(R"({"0x0000000000000000000000000000000000000c02" : { "balance" : "0x01" }})"))),
+        FH32::zero());
+
+    // Upgraded tool at the same path does not get the roots of the previous version
+    string const oldKey = GenesisCache::makeKey(genesis, FORK("Berlin"), "/bin/evm", "evm version 1.0");
+    string const newKey = GenesisCache::makeKey(genesis, FORK("Berlin"), "/bin/evm", "evm version 1.1");
+    BOOST_CHECK(oldKey != newKey);
+    GenesisCache::insert(oldKey, "0x02");
+
+    string root;
+    BOOST_CHECK(GenesisCache::find(oldKey, root));
+    BOOST_CHECK(!GenesisCache::find(newKey, root));
+}
+
+BOOST_AUTO_TEST_CASE(transitionCache_hitMiss)
+{
+    TransitionCacheScope scope(1);
+    string response;
+    BOOST_CHECK(!TransitionCache::find("aa", response));
+    TransitionCache::insert("aa", "{\"result\":{},\"alloc\":{}}");
+    BOOST_REQUIRE(TransitionCache::find("aa", response));
+    BOOST_CHECK_EQUAL(response, "{\"result\":{},\"alloc\":{}}");
+    BOOST_CHECK(!TransitionCache::find("bb", response));
+
+    TransitionCacheStats const stats = TransitionCache::stats();
+    BOOST_CHECK_EQUAL(stats.hits, 1);
+    BOOST_CHECK_EQUAL(stats.misses, 2);
+    BOOST_CHECK_EQUAL(stats.stores, 1);
+    BOOST_CHECK_EQUAL(stats.evictions, 0);
+}
+
+BOOST_AUTO_TEST_CASE(transitionCache_evictAtLimit)
+{
+    // 3 records of 400KB do not fit 1MB, the least recently used one is evicted down to 90% of the limit
+    TransitionCacheScope scope(1);
+    string const record(400 * 1024, 'r');
+    TransitionCache::insert("aa", record);
+    TransitionCache::insert("bb", record);
+    BOOST_CHECK_EQUAL(TransitionCache::stats().evictions, 0);
+    TransitionCache::insert("cc", record);
+    BOOST_CHECK_EQUAL(TransitionCache::stats().evictions, 1);
+
+    string response;
+    BOOST_CHECK(!TransitionCache::find("aa", response));
+    BOOST_CHECK(TransitionCache::find("bb", response));
+    BOOST_CHECK(TransitionCache::find("cc", response));
+    BOOST_CHECK_EQUAL(response.size(), record.size());
+}
+
+BOOST_AUTO_TEST_CASE(transitionCache_evictLeastRecentlyUsed)
+{
+    // Records used within the same second are evicted by use order, not by key order
+    TransitionCacheScope scope(1);
+    string const record(400 * 1024, 'r');
+    TransitionCache::insert("bb", record);
+    TransitionCache::insert("cc", record);
+    string response;
+    BOOST_REQUIRE(TransitionCache::find("bb", response));
+    TransitionCache::insert("00", record);
+    BOOST_CHECK_EQUAL(TransitionCache::stats().evictions, 1);
+
+    BOOST_CHECK(TransitionCache::find("00", response));
+    BOOST_CHECK(TransitionCache::find("bb", response));
+    BOOST_CHECK(!TransitionCache::find("cc", response));
+}
+
+BOOST_AUTO_TEST_SUITE_END()